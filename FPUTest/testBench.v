@@ -33,23 +33,26 @@ reg [63:0] rs1;
 reg [63:0] rs2;
 reg [63:0] rs3;
 
-wire busy;
+reg  [1:0]  state;
+wire        resultValid;
 wire [63:0] fpuOut;
-FPU fpu(
+FPUPipe fpu(
         .clk_i(clk),
         .reset_i(rst),
-        .fpuEnable_i(1'b1),
+        .issue_i(state == 2'd1),
         .instr_i(instr),
+        .rdId_i(6'b0),
         .rs1_i(rs1),
         .rs2_i(rs2),
         .rs3_i(rs3),
         .rm_i(3'b000),
-        .fflags_o(),
-        .busy_o(busy),
-        .fpuOut_o(fpuOut)
+        .finishing_o(),
+        .finishingRdId_o(),
+        .resultValid_o(resultValid),
+        .resultRdId_o(),
+        .result_o(fpuOut)
 );
 
-reg state;
 always @(posedge clk) begin
         if (rst == 1'b1) begin
                 state <= 0;
@@ -64,6 +67,10 @@ always @(posedge clk) begin
                                 state <= 1;
                         end
                         1: begin
+                                // Issue into the pipeline
+                                state <= 2;
+                        end
+                        2: if (resultValid) begin
                                 $display("%f + %f = %f", rs1, rs2, fpuOut);
                                 outputFile = $fopen("resp_z", "a");
                                 $fdisplayh(outputFile, fpuOut);
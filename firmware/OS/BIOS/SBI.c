@@ -21,6 +21,26 @@ void sbi_shutdown(void) {
         asm volatile ("ebreak\n");
 }
 
+// Writing -1 to the low half first keeps the timer from firing early
+void sbi_set_timer(u32 stime_lo, u32 stime_hi) {
+        asm volatile ("csrw %0, %1" :: "i"(CSR_STIMECMP), "r"(-1));
+        asm volatile ("csrw %0, %1" :: "i"(CSR_STIMECMPH), "r"(stime_hi));
+        asm volatile ("csrw %0, %1" :: "i"(CSR_STIMECMP), "r"(stime_lo));
+}
+
+// EID #0x54494D45
+struct sbiret timer(long arg0, long arg1, long fid) {
+        struct sbiret ret = {0};
+        switch (fid) {
+                case 0x0:
+                        sbi_set_timer(arg0, arg1);
+                        break;
+                default:
+                        ret.error = SBI_ERR_NOT_SUPPORTED;
+        }
+        return ret;
+}
+
 struct sbiret sbi_debug_console_write(u32 num_bytes, char *base_addr_lo, char *base_addr_hi) {
         for (int i = 0; i < num_bytes; i++) {
                 _putchar(base_addr_lo[i]);
@@ -52,6 +72,9 @@ struct sbiret sbi_handler(long arg0, long arg1, long arg2, long arg3, long arg4,
                 case 0x08:
                         sbi_shutdown();
                         break;
+                case 0x54494D45:
+                        ret = timer(arg0, arg1, fid);
+                        break;
                 case 0x4442434E:
                         ret = dbcn(arg0, arg1, arg2, arg3, arg4, arg5, fid);
                         break;
@@ -30,6 +30,9 @@ typedef uint8_t  u8;
 typedef uint16_t u16;
 typedef uint32_t u32;
 
+#define CSR_STIMECMP              0x14D
+#define CSR_STIMECMPH             0x15D
+
 struct sbiret {
         long error;
         union {
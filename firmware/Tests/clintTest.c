@@ -0,0 +1,103 @@
+/*************************************************
+ *File----------clintTest.c
+ *Project-------Risc-V-FPGA
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 09:31:17 UTC
+ *License-------GNU GPL-3.0
+ ************************************************/
+
+/*
+ * CLINT test, build with TEST=clintTest (and DUALCORE=1 for both harts)
+ * Every hart programs and reads back its own mtimecmp and msip, and waits for
+ * mip.MTIP and mip.MSIP to follow them. Interrupts stay disabled in mie, so
+ * only the pending bits are checked.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../libs/io.h"
+#include "../libs/perf.h"
+#include "../libs/smp.h"
+
+#define MIP_MSIP                (1 << 3)
+#define MIP_MTIP                (1 << 7)
+#define TIMER_DELAY             200     // mtime ticks
+#define TIMER_TIMEOUT           5000
+
+static volatile uint32_t errors[HARTS];
+
+static void check(int hart, int ok) {
+        if (!ok)
+                errors[hart]++;
+}
+
+static uint64_t mtime(void) {
+        uint32_t hi, lo;
+        do {
+                hi = IO_IN(CLINT_MTIME + 4);
+                lo = IO_IN(CLINT_MTIME);
+        } while (hi != IO_IN(CLINT_MTIME + 4));
+        return ((uint64_t)hi << 32) | lo;
+}
+
+static void setMtimecmp(int hart, uint64_t when) {
+        // All ones in the high half first so the timer never fires early
+        IO_OUT(CLINT_MTIMECMP(hart) + 4, 0xFFFFFFFF);
+        IO_OUT(CLINT_MTIMECMP(hart), (uint32_t)when);
+        IO_OUT(CLINT_MTIMECMP(hart) + 4, when >> 32);
+}
+
+static uint32_t tag(int hart) {
+        return 0x1000 * (hart + 1);
+}
+
+// Every hart leaves a different value in its own mtimecmp
+static void writeTags(int hart) {
+        setMtimecmp(hart, 0xFFFFFFFF00000000ULL | tag(hart));
+}
+
+static void timerAndSoft(int hart) {
+        // Its own tag, not the one at hart 0's address
+        check(hart, IO_IN(CLINT_MTIMECMP(hart)) == tag(hart));
+        check(hart, IO_IN(CLINT_MTIMECMP(hart) + 4) == 0xFFFFFFFF);
+        check(hart, !(csr_read(CSR_MIP) & MIP_MTIP));
+
+        uint64_t when = mtime() + TIMER_DELAY;
+        setMtimecmp(hart, when);
+        check(hart, IO_IN(CLINT_MTIMECMP(hart)) == (uint32_t)when);
+        check(hart, !(csr_read(CSR_MIP) & MIP_MTIP));
+        while (!(csr_read(CSR_MIP) & MIP_MTIP)) {
+                if (mtime() > when + TIMER_TIMEOUT) {
+                        check(hart, 0);
+                        break;
+                }
+        }
+        check(hart, mtime() >= when);
+        setMtimecmp(hart, ~0ULL);
+        check(hart, !(csr_read(CSR_MIP) & MIP_MTIP));
+
+        IO_OUT(CLINT_MSIP(hart), 1);
+        check(hart, IO_IN(CLINT_MSIP(hart)) == 1);
+        check(hart, csr_read(CSR_MIP) & MIP_MSIP);
+        IO_OUT(CLINT_MSIP(hart), 0);
+        check(hart, IO_IN(CLINT_MSIP(hart)) == 0);
+        check(hart, !(csr_read(CSR_MIP) & MIP_MSIP));
+}
+
+int main(void) {
+        int fail = 0;
+
+        smp_run(writeTags);
+        for (int h = 0; h < HARTS; h++)
+                check(0, IO_IN(CLINT_MTIMECMP(h)) == tag(h));
+        smp_run(timerAndSoft);
+
+        for (int h = 0; h < HARTS; h++) {
+                printf("CLINT hart %d: %d errors\n", h, errors[h]);
+                fail |= (errors[h] != 0);
+        }
+        printf("CLINT test %s\n", fail ? "FAILED" : "PASSED");
+
+        return fail;
+}
@@ -0,0 +1,149 @@
+/*************************************************
+ *File----------mipTest.c
+ *Project-------Risc-V-FPGA
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 09:48:52 UTC
+ *License-------GNU GPL-3.0
+ ************************************************/
+
+/*
+ * mip test, build with TEST=mipTest
+ * Reads mip, and writes it back unchanged, while LCOFIP and STIP become
+ * pending. A read must not write mip, and a write must not clear a bit raised
+ * after execute read the old value. Interrupts stay disabled in mstatus, so
+ * only the pending bits are checked.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../libs/perf.h"
+
+#define CSR_MENVCFGH            0x31A
+#define CSR_STIMECMP            0x14D
+#define CSR_STIMECMPH           0x15D
+#define CSR_TIME                0xC01
+#define CSR_TIMEH               0xC81
+#define MENVCFGH_STCE           (1u << 31)
+#define MIP_STIP                (1 << 5)
+#define TIMER_DELAY             200     // mtime ticks
+#define TRIES                   100000
+#define REREADS                 64
+
+static int errors = 0;
+
+static void check(const char *what, int ok) {
+        if (!ok) {
+                printf("  %s failed\n", what);
+                errors++;
+        }
+}
+
+static uint64_t rdtime(void) {
+        uint32_t hi, lo;
+        do {
+                hi = csr_read(CSR_TIMEH);
+                lo = csr_read(CSR_TIME);
+        } while (hi != csr_read(CSR_TIMEH));
+        return ((uint64_t)hi << 32) | lo;
+}
+
+// csrc with a zero register: a real write of the value just read
+static void mipWriteBack(void) {
+        uint32_t zero = 0;
+        asm volatile ("csrc %0, %1" :: "i"(CSR_MIP), "r"(zero));
+}
+
+// Data dependent branches, so the branch mispredict counter moves
+static volatile uint32_t noise = 0x1234567;
+static void mispredict(void) {
+        uint32_t x = noise;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        if (x & 1)
+                noise = x;
+        else
+                noise = x + 1;
+}
+
+// Overflow raised while mip is read (write == 0) or written back (write == 1)
+static void lcofWhile(int write) {
+        int n;
+
+        hpm_inhibit(0);
+        hpm_setEvent(3, HPM_BRANCH_MISS);
+        hpm_write(3, -(uint64_t)8);
+        hpm_clearOverflow(3);
+        csr_clear(CSR_MIP, MIP_LCOFIP);
+
+        for (n = 0; n < TRIES; n++) {
+                mispredict();
+                if (write)
+                        mipWriteBack();
+                if (csr_read(CSR_MIP) & MIP_LCOFIP)
+                        break;
+        }
+        check(write ? "LCOFIP raised (csrc)" : "LCOFIP raised (csrr)", n < TRIES);
+        check("overflow bit set", hpm_overflows() & (1 << 3));
+
+        for (n = 0; n < REREADS; n++) {
+                if (write)
+                        mipWriteBack();
+                if (!(csr_read(CSR_MIP) & MIP_LCOFIP))
+                        break;
+        }
+        check("LCOFIP stays set", n == REREADS);
+
+        hpm_setEvent(3, HPM_NONE);
+        hpm_clearOverflow(3);
+        csr_clear(CSR_MIP, MIP_LCOFIP);
+        check("LCOFIP cleared", !(csr_read(CSR_MIP) & MIP_LCOFIP));
+}
+
+// Supervisor timer from stimecmp (Sstc) while mip is read and written back
+static void stipWhile(void) {
+        int n;
+
+        csr_set(CSR_MENVCFGH, MENVCFGH_STCE);
+        uint64_t when = rdtime() + TIMER_DELAY;
+        csr_write(CSR_STIMECMP, -1);
+        csr_write(CSR_STIMECMPH, when >> 32);
+        csr_write(CSR_STIMECMP, when);
+        check("STIP clear before stimecmp", !(csr_read(CSR_MIP) & MIP_STIP));
+
+        for (n = 0; n < TRIES; n++) {
+                mipWriteBack();
+                if (csr_read(CSR_MIP) & MIP_STIP)
+                        break;
+        }
+        check("STIP raised", n < TRIES);
+        check("STIP not early", rdtime() >= when);
+
+        // stimecmp owns STIP, a write to mip cannot clear it
+        csr_clear(CSR_MIP, MIP_STIP);
+        for (n = 0; n < REREADS; n++) {
+                mipWriteBack();
+                if (!(csr_read(CSR_MIP) & MIP_STIP))
+                        break;
+        }
+        check("STIP stays set", n == REREADS);
+
+        csr_write(CSR_STIMECMPH, -1);
+        csr_write(CSR_STIMECMP, -1);
+        check("STIP cleared by stimecmp", !(csr_read(CSR_MIP) & MIP_STIP));
+        csr_clear(CSR_MENVCFGH, MENVCFGH_STCE);
+}
+
+int main(void) {
+        printf("LCOFIP while reading mip\n");
+        lcofWhile(0);
+        printf("LCOFIP while writing mip back\n");
+        lcofWhile(1);
+        printf("STIP while writing mip back\n");
+        stipWhile();
+
+        printf("mip test %s\n", errors ? "FAILED" : "PASSED");
+
+        return errors;
+}
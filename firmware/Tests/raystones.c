@@ -17,6 +17,7 @@
 #include <stdlib.h>
 
 #include "../libs/perf.h"
+#include "../libs/smp.h"
 
 /*******************************************************************/
 
@@ -89,7 +90,7 @@ void graphics_set_pixel(int x, int y, float r, float g, float b) {
         uint8_t B = (uint8_t)(255.0f * b);
         // graphics output deactivated for bench run
         if(bench_run) {
-                if(y & 1) {
+                if((y & 1) && hart_id() == 0) {
                         if(x == graphics_width-1) {
                                 printf("%d",y/2);
                         }
@@ -183,6 +184,7 @@ static inline void stats_end_frame() {
                         "no gfx output (measurement is accurate)" :
                         "gfx output (measurement is NOT accurate)"
               );
+        printf("INSTRET=%d     ", (int)instret);
         printf("CPI="); printk(kCPI); printf("     ");
         printf("RAYSTONES="); printk(kRAYSTONES);
         printf("\n");
@@ -459,8 +461,34 @@ static void render_pixel(
         stats_end_pixel();
 }
 
+static Sphere* render_spheres;
+static int render_nb_spheres;
+static Light* render_lights;
+static int render_nb_lights;
+
+// Bench pass: each hart renders every HARTS-th pair of rows
+static void render_rows(int hart) {
+        for (int j = hart*2; j<graphics_height; j+=2*HARTS) { 
+                for (int i = 0; i<graphics_width; i++) {
+                        render_pixel(i,j  ,render_spheres,render_nb_spheres,
+                                        render_lights,render_nb_lights);
+                        render_pixel(i,j+1,render_spheres,render_nb_spheres,
+                                        render_lights,render_nb_lights);	  
+                }
+        }
+}
+
 void render(Sphere* spheres, int nb_spheres, Light* lights, int nb_lights) {
         stats_begin_frame();
+        if(bench_run) {
+                render_spheres = spheres;
+                render_nb_spheres = nb_spheres;
+                render_lights = lights;
+                render_nb_lights = nb_lights;
+                smp_run(render_rows);
+                stats_end_frame();
+                return;
+        }
 #ifdef graphics_double_lines  
         // for (int j = 0; j<1; j+=2) { 
         //         for (int i = 25; i<28; i++) {
@@ -0,0 +1,156 @@
+/*************************************************
+ *File----------sstcBench.c
+ *Project-------Risc-V-FPGA
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 10:05:36 UTC
+ *License-------GNU GPL-3.0
+ ************************************************/
+
+/*
+ * Timer tick benchmark, build with TEST=sstcBench
+ * Takes TICKS supervisor timer ticks per path and reprograms the next one
+ * either through an SBI set_timer ECALL or by writing stimecmp directly
+ * (Sstc). The ECALL goes to a trap handler that saves and restores every
+ * register like the BIOS does. Prints the cycles each reprogram costs.
+ * Interrupts stay disabled and the ticks are polled in mip, so both paths
+ * pay the same to take a tick and only the reprogram is measured.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../libs/perf.h"
+
+#define CSR_MTVEC               0x305
+#define CSR_MSCRATCH            0x340
+#define CSR_MEPC                0x341
+#define CSR_MENVCFGH            0x31A
+#define CSR_STIMECMP            0x14D
+#define CSR_STIMECMPH           0x15D
+#define CSR_CYCLE               0xC00
+#define CSR_TIME                0xC01
+#define CSR_TIMEH               0xC81
+#define MENVCFGH_STCE           (1u << 31)
+#define MIP_STIP                (1 << 5)
+#define MCAUSE_ECALL_M          11
+#define SBI_EXT_TIME            0x54494D45
+#define TICKS                   32
+#define TICK_PERIOD             4000    // mtime ticks
+#define TRAP_STACK              256     // words
+
+static uint32_t trapStack[TRAP_STACK];
+static int errors = 0;
+
+static uint64_t rdtime(void) {
+        uint32_t hi, lo;
+        do {
+                hi = csr_read(CSR_TIMEH);
+                lo = csr_read(CSR_TIME);
+        } while (hi != csr_read(CSR_TIMEH));
+        return ((uint64_t)hi << 32) | lo;
+}
+
+// Writing -1 to the low half first keeps the timer from firing early
+static void setStimecmp(uint32_t lo, uint32_t hi) {
+        csr_write(CSR_STIMECMP, -1);
+        csr_write(CSR_STIMECMPH, hi);
+        csr_write(CSR_STIMECMP, lo);
+}
+
+/*
+ * M mode trap entry, the same frame as m_trap in the BIOS: 31 registers on
+ * the stack in mscratch, then the C handler with the frame and mcause.
+ */
+#define SAVE(r, n)      "sw " #r ", 4 * " #n "(sp)\n"
+#define LOAD(r, n)      "lw " #r ", 4 * " #n "(sp)\n"
+#define REGS(op) \
+        op(ra, 0)  op(gp, 1)  op(tp, 2)  op(t0, 3)  op(t1, 4)  op(t2, 5) \
+        op(t3, 6)  op(t4, 7)  op(t5, 8)  op(t6, 9)  op(a0, 10) op(a1, 11) \
+        op(a2, 12) op(a3, 13) op(a4, 14) op(a5, 15) op(a6, 16) op(a7, 17) \
+        op(s0, 18) op(s1, 19) op(s2, 20) op(s3, 21) op(s4, 22) op(s5, 23) \
+        op(s6, 24) op(s7, 25) op(s8, 26) op(s9, 27) op(s10, 28) op(s11, 29)
+
+asm (
+        ".section .text\n"
+        ".align 2\n"
+        "mTrap:\n"
+        "csrrw sp, mscratch, sp\n"
+        "addi sp, sp, -4 * 31\n"
+        REGS(SAVE)
+        "csrr a0, mscratch\n"
+        "sw a0, 4 * 30(sp)\n"
+        "addi a0, sp, 4 * 31\n"
+        "csrw mscratch, a0\n"
+        "mv a0, sp\n"
+        "csrr a1, mcause\n"
+        "call mTrapHandler\n"
+        REGS(LOAD)
+        "lw sp, 4 * 30(sp)\n"
+        "mret\n"
+);
+extern void mTrap(void);
+
+// SBI TIME extension (EID a7, FID a6), everything else is counted as an error
+void mTrapHandler(uint32_t *regs, uint32_t cause) {
+        if (cause == MCAUSE_ECALL_M && regs[17] == SBI_EXT_TIME && regs[16] == 0) {
+                setStimecmp(regs[10], regs[11]);
+                regs[10] = 0;
+        } else {
+                errors++;
+        }
+        csr_write(CSR_MEPC, csr_read(CSR_MEPC) + 4);
+}
+
+static void sbiSetTimer(uint64_t when) {
+        register uint32_t a0 asm ("a0") = when;
+        register uint32_t a1 asm ("a1") = when >> 32;
+        register uint32_t a6 asm ("a6") = 0;
+        register uint32_t a7 asm ("a7") = SBI_EXT_TIME;
+        asm volatile ("ecall" : "+r"(a0), "+r"(a1) : "r"(a6), "r"(a7) : "memory");
+        if (a0 != 0)
+                errors++;
+}
+
+static void setTimer(int viaSbi, uint64_t when) {
+        if (viaSbi)
+                sbiSetTimer(when);
+        else
+                setStimecmp(when, when >> 32);
+}
+
+// Average cycles to reprogram the next tick
+static uint32_t tickBench(int viaSbi) {
+        uint32_t cycles = 0;
+
+        setTimer(viaSbi, rdtime() + TICK_PERIOD);
+        for (int n = 0; n < TICKS; n++) {
+                while (!(csr_read(CSR_MIP) & MIP_STIP));
+                uint64_t next = rdtime() + TICK_PERIOD;
+                uint32_t start = csr_read(CSR_CYCLE);
+                setTimer(viaSbi, next);
+                cycles += csr_read(CSR_CYCLE) - start;
+                if (csr_read(CSR_MIP) & MIP_STIP)
+                        errors++;
+        }
+        setStimecmp(-1, -1);
+
+        return cycles / TICKS;
+}
+
+int main(void) {
+        csr_write(CSR_MSCRATCH, &trapStack[TRAP_STACK]);
+        csr_write(CSR_MTVEC, mTrap);
+        csr_set(CSR_MENVCFGH, MENVCFGH_STCE);
+
+        printf("Timer tick benchmark: %d ticks, %d mtime ticks apart\n", TICKS, TICK_PERIOD);
+        uint32_t sbiCycles  = tickBench(1);
+        uint32_t sstcCycles = tickBench(0);
+        printf("SBI set_timer:  %d cycles per tick\n", sbiCycles);
+        printf("Sstc stimecmp:  %d cycles per tick\n", sstcCycles);
+        printf("Trap path saved %d cycles per tick\n", sbiCycles - sstcCycles);
+
+        csr_clear(CSR_MENVCFGH, MENVCFGH_STCE);
+        printf("Sstc benchmark %s\n", errors ? "FAILED" : "PASSED");
+
+        return errors;
+}
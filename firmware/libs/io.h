@@ -15,6 +15,12 @@
 #define IO_UART_DAT   8
 #define IO_UART_CNTL  16
 
+// CLINT, a 64 KiB window after the other devices
+#define IO_CLINT              0x10000
+#define CLINT_MSIP(hart)      (IO_CLINT + 4*(hart))
+#define CLINT_MTIMECMP(hart)  (IO_CLINT + 0x4000 + 8*(hart))
+#define CLINT_MTIME           (IO_CLINT + 0xBFF8)
+
 #define IO_IN(port)       *(volatile uint32_t*)(IO_BASE + port)
 #define IO_OUT(port,val)  *(volatile uint32_t*)(IO_BASE + port)=(val)
 
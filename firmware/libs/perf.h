@@ -13,5 +13,81 @@
 extern uint64_t rdcycle();
 extern uint64_t rdinstret();
 
-#endif
+/*
+ * Hardware performance counters (Zihpm, Sscofpmf)
+ * mhpmcounter3 - mhpmcounter(3+HPM_COUNTERS-1) count the event selected with
+ * hpm_setEvent(). Counter numbers must be constants.
+ * hpm_sample() arms a counter to overflow after a number of events. The
+ * overflow raises the local counter overflow interrupt (mcause 0x8000000D)
+ * once mstatus.MIE is set. The handler must clear MIP_LCOFIP and the counter's
+ * overflow bit with hpm_clearOverflow() before re-arming it.
+ */
+#define HPM_COUNTERS            4
+
+// Events
+#define HPM_NONE                0
+#define HPM_BRANCH_MISS         1       // Branch mispredicts
+#define HPM_JALR_MISS           2       // JALR mispredicts
+#define HPM_DATA_STALL          3       // Data hazard stall cycles (MUL-use, load after store)
+#define HPM_LONG_STALL          4       // Stall cycles waiting on DIV/FPU results
+#define HPM_EXEC_BUSY           5       // Divider/FPU busy cycles
+#define HPM_CSR_STALL           6       // CSR hazard stall cycles
+#define HPM_ICACHE_MISS         7       // Instruction cache miss cycles
+#define HPM_DCACHE_STALL        8       // Data cache stall cycles
+
+// CSRs
+#define CSR_MCOUNTINHIBIT       0x320
+#define CSR_MHPMEVENT(n)        (0x320 + (n))
+#define CSR_MHPMEVENTH(n)       (0x720 + (n))
+#define CSR_MHPMCOUNTER(n)      (0xB00 + (n))
+#define CSR_MHPMCOUNTERH(n)     (0xB80 + (n))
+#define CSR_HPMCOUNTER(n)       (0xC00 + (n))   // Read only aliases
+#define CSR_HPMCOUNTERH(n)      (0xC80 + (n))
+#define CSR_SCOUNTOVF           0xDA0
+#define CSR_MIE                 0x304
+#define CSR_MIP                 0x344
+#define MIP_LCOFIP              (1 << 13)
+#define MIE_LCOFIE              (1 << 13)
+#define MCOUNTINHIBIT_CY        (1 << 0)
+#define MCOUNTINHIBIT_IR        (1 << 2)
+#define MCOUNTINHIBIT_HPM(n)    (1 << (n))
+
+#define csr_read(csr) ({ \
+        uint32_t __v; \
+        asm volatile ("csrr %0, %1" : "=r"(__v) : "i"(csr)); \
+        __v; })
+#define csr_write(csr, val) \
+        asm volatile ("csrw %0, %1" :: "i"(csr), "r"((uint32_t)(val)))
+#define csr_set(csr, val) \
+        asm volatile ("csrs %0, %1" :: "i"(csr), "r"((uint32_t)(val)))
+#define csr_clear(csr, val) \
+        asm volatile ("csrc %0, %1" :: "i"(csr), "r"((uint32_t)(val)))
+
+#define hpm_setEvent(n, event)  csr_write(CSR_MHPMEVENT(n), (event))
+#define hpm_clearOverflow(n)    csr_write(CSR_MHPMEVENTH(n), 0)
+#define hpm_overflows()         csr_read(CSR_SCOUNTOVF)
+#define hpm_inhibit(mask)       csr_write(CSR_MCOUNTINHIBIT, (mask))
 
+#define hpm_read(n) ({ \
+        uint32_t __h, __l; \
+        do { \
+                __h = csr_read(CSR_HPMCOUNTERH(n)); \
+                __l = csr_read(CSR_HPMCOUNTER(n)); \
+        } while (__h != csr_read(CSR_HPMCOUNTERH(n))); \
+        ((uint64_t)__h << 32) | __l; })
+
+#define hpm_write(n, val) do { \
+        uint64_t __v = (val); \
+        csr_write(CSR_MHPMCOUNTER(n), 0); \
+        csr_write(CSR_MHPMCOUNTERH(n), __v >> 32); \
+        csr_write(CSR_MHPMCOUNTER(n), __v); \
+} while (0)
+
+// Interrupt after period more events
+#define hpm_sample(n, period) do { \
+        hpm_write(n, -(uint64_t)(period)); \
+        hpm_clearOverflow(n); \
+        csr_set(CSR_MIE, MIE_LCOFIE); \
+} while (0)
+
+#endif
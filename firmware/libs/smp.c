@@ -0,0 +1,38 @@
+/*************************************************
+ *File----------smp.c
+ *Project-------Risc-V-FPGA
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 03:44:02 UTC
+ *License-------GNU GPL-3.0
+ ************************************************/
+
+#include "smp.h"
+
+static void (*volatile smp_fn)(int hart);
+static volatile uint32_t smp_gen = 0;   // Bumped for every smp_run
+static volatile uint32_t smp_done = 0;  // Harts finished with the current run
+
+void smp_secondary(void) {
+        uint32_t gen = smp_gen;
+        for (;;) {
+                while (smp_gen == gen)
+                        ;
+                gen = smp_gen;
+                __atomic_thread_fence(__ATOMIC_ACQUIRE);
+                smp_fn(hart_id());
+                __atomic_fetch_add(&smp_done, 1, __ATOMIC_RELEASE);
+        }
+}
+
+void smp_run(void (*fn)(int hart)) {
+        smp_fn = fn;
+        smp_done = 0;
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        smp_gen++;
+
+        fn(0);
+        __atomic_fetch_add(&smp_done, 1, __ATOMIC_RELEASE);
+        while (smp_done != HARTS)
+                ;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
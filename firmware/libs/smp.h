@@ -0,0 +1,35 @@
+/*************************************************
+ *File----------smp.h
+ *Project-------Risc-V-FPGA
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 03:41:26 UTC
+ *License-------GNU GPL-3.0
+ ************************************************/
+#ifndef SMP_H
+#define SMP_H
+
+#include <stdint.h>
+
+/*
+ * Multi-hart support (DUALCORE=1 builds, startPipelineMP.S)
+ * Hart 0 runs main(). The other harts wait in smp_secondary() until hart 0
+ * calls smp_run(), which runs the function on every hart and returns once
+ * they have all finished. Only hart 0 should print.
+ */
+#ifndef HARTS
+#define HARTS                   1
+#endif
+
+static inline int hart_id(void) {
+        uint32_t id;
+        asm volatile ("csrr %0, mhartid" : "=r"(id));
+        return id;
+}
+
+// Run fn(hart) on all harts and wait for them
+void smp_run(void (*fn)(int hart));
+
+// Entry for harts other than 0
+void smp_secondary(void);
+
+#endif
@@ -0,0 +1,109 @@
+/*************************************************
+ *File----------CLINT.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 08:21:36 UTC
+ ************************************************/
+/* verilator lint_off WIDTH */
+
+module CLINT #(
+        parameter HARTS = 1,
+        parameter TICK_DIV = 1          // Clock cycles per mtime tick
+)(
+        input  wire             clk_i,
+        input  wire             reset_i,
+        // IO Bus (offset in the 64 KiB CLINT window)
+        input  wire [15:0]      addr_i,
+        output reg  [31:0]      rData_o,
+        input  wire [31:0]      wData_i,
+        input  wire             wr_i,
+        // Interrupts, bit N for hart N
+        output wire [HARTS-1:0] timerIrq_o,     // mip.MTIP
+        output wire [HARTS-1:0] softIrq_o,      // mip.MSIP
+        output wire [63:0]      mtime_o         // time CSR and Sstc stimecmp
+);
+
+/*
+ * Core local interruptor with the SiFive CLINT register layout:
+ *   0x0000 + 4*hart  msip      bit 0 raises the software interrupt
+ *   0x4000 + 8*hart  mtimecmp  timer interrupt while mtime >= mtimecmp
+ *   0xBFF8           mtime     64 bit, counts every TICK_DIV cycles
+ * Registers are 32 bits wide, 64 bit ones are written a word at a time.
+ * mtimecmp resets to all ones so no timer interrupt is pending at reset.
+ */
+
+localparam MSIP_BASE     = 16'h0000;
+localparam MTIMECMP_BASE = 16'h4000;
+localparam MTIME_BASE    = 16'hBFF8;
+
+reg [63:0] mtime = 0;
+reg [63:0] mtimecmp [0:HARTS-1];
+reg [HARTS-1:0] msip = 0;
+
+assign mtime_o = mtime;
+
+reg [31:0] tickCount = 0;
+wire tick = (tickCount == TICK_DIV - 1);
+
+genvar g;
+generate
+        for (g = 0; g < HARTS; g = g + 1) begin : irq
+                assign timerIrq_o[g] = (mtime >= mtimecmp[g]);
+                assign softIrq_o[g]  = msip[g];
+        end
+endgenerate
+
+// Register selected by the address
+wire [15:0] cmpOff  = addr_i - MTIMECMP_BASE;
+wire        isMsip  = (addr_i < MSIP_BASE + 4*HARTS);
+wire        isCmp   = (addr_i >= MTIMECMP_BASE) && (addr_i < MTIMECMP_BASE + 8*HARTS);
+wire        isMtime = (addr_i[15:3] == MTIME_BASE[15:3]);
+wire [15:0] msipIdx = addr_i[15:2];
+wire [15:0] cmpIdx  = cmpOff[15:3];
+
+always @(*) begin
+        rData_o = 32'b0;
+        if (isMsip)
+                rData_o = {31'b0, msip[msipIdx]};
+        else if (isCmp)
+                rData_o = addr_i[2] ? mtimecmp[cmpIdx][63:32] : mtimecmp[cmpIdx][31:0];
+        else if (isMtime)
+                rData_o = addr_i[2] ? mtime[63:32] : mtime[31:0];
+end
+
+integer h;
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                mtime     <= 64'b0;
+                msip      <= 0;
+                tickCount <= 0;
+                for (h = 0; h < HARTS; h = h + 1)
+                        mtimecmp[h] <= {64{1'b1}};
+        end else begin
+                tickCount <= tick ? 0 : tickCount + 1;
+                if (tick)
+                        mtime <= mtime + 1;
+
+                // Software writes after the tick so they take effect
+                if (wr_i) begin
+                        if (isMsip)
+                                msip[msipIdx] <= wData_i[0];
+                        if (isCmp) begin
+                                if (addr_i[2])
+                                        mtimecmp[cmpIdx][63:32] <= wData_i;
+                                else
+                                        mtimecmp[cmpIdx][31:0]  <= wData_i;
+                        end
+                        if (isMtime) begin
+                                if (addr_i[2])
+                                        mtime[63:32] <= wData_i;
+                                else
+                                        mtime[31:0]  <= wData_i;
+                        end
+                end
+        end
+end
+
+endmodule
+/* verilator lint_on WIDTH */
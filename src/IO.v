@@ -6,7 +6,9 @@
  *Created-------Monday Dec 01, 2025 16:48:14 UTC
  ************************************************/
 
-module IO (
+module IO #(
+        parameter HARTS = 1
+)(
         input  wire        clk_i,
         input  wire        reset_i,
         input  wire [31:0] IO_memAddr_i,
@@ -14,9 +16,15 @@ module IO (
         input  wire [31:0] IO_memWData_i,
         input  wire        IO_memWr_i,
         output wire [3:0]  leds_o,
-        output wire        txd_o
+        output wire        txd_o,
+        // Machine timer and software interrupts, bit N for hart N
+        output wire [HARTS-1:0] timerIrq_o,
+        output wire [HARTS-1:0] softIrq_o,
+        output wire [63:0]      mtime_o
 );
-wire [13:0] IO_wordAddr = IO_memAddr_i[15:2];
+// The CLINT has the 64 KiB window after the other devices
+wire        IO_isCLINT  = IO_memAddr_i[16];
+wire [13:0] IO_wordAddr = IO_isCLINT ? 14'b0 : IO_memAddr_i[15:2];
 
 // Output Indicators
 localparam IO_LEDS_bit          = 0;
@@ -34,8 +42,25 @@ end
 wire uartValid = IO_memWr_i & IO_wordAddr[IO_UART_DAT_bit];
 wire uartBusy;
 
-assign IO_memRData_o = IO_wordAddr[IO_UART_CTRL_bit] ? {22'b0, uartBusy, 9'b0}
+wire [31:0] clintRData;
+
+assign IO_memRData_o = IO_isCLINT                      ? clintRData :
+                       IO_wordAddr[IO_UART_CTRL_bit] ? {22'b0, uartBusy, 9'b0}
                                                     : 32'b0;
+
+CLINT #(
+        .HARTS(HARTS)
+)clint(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .addr_i(IO_memAddr_i[15:0]),
+        .rData_o(clintRData),
+        .wData_i(IO_memWData_i),
+        .wr_i(IO_memWr_i && IO_isCLINT),
+        .timerIrq_o(timerIrq_o),
+        .softIrq_o(softIrq_o),
+        .mtime_o(mtime_o)
+);
 // 115200 baud, 8-bit, no parity, 1 stop bit
 localparam UART_SETUP = {1'b0, 2'b00, 1'b0, 3'b000, 24'h0000D9};
 
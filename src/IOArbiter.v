@@ -0,0 +1,65 @@
+/*************************************************
+ *File----------IOArbiter.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 09:12:40 UTC
+ ************************************************/
+
+module IOArbiter (
+        input  wire        clk_i,
+        input  wire        reset_i,
+        // Hart 0
+        input  wire        h0Req_i,         // IO access in execute
+        output wire        h0Grant_o,       // Access may move to the memory unit
+        input  wire [31:0] h0Addr_i,
+        output wire [31:0] h0RData_o,
+        input  wire [31:0] h0WData_i,
+        input  wire        h0Wr_i,
+        // Hart 1
+        input  wire        h1Req_i,
+        output wire        h1Grant_o,
+        input  wire [31:0] h1Addr_i,
+        output wire [31:0] h1RData_o,
+        input  wire [31:0] h1WData_i,
+        input  wire        h1Wr_i,
+        // IO
+        output wire [31:0] IO_memAddr_o,
+        input  wire [31:0] IO_memRData_i,
+        output wire [31:0] IO_memWData_o,
+        output wire        IO_memWr_o
+);
+
+/*
+ * Shares the IO port between two harts, round robin between requests.
+ * IO is accessed in the memory unit, which never stalls, so a hart asks for
+ * the port while its access is in execute and waits there until granted.
+ * The granted hart owns the port in the next cycle, when its access is in the
+ * memory unit; a hart stalled for another reason just wastes its grant.
+ */
+
+reg last = 1'b1;        // Hart granted most recently
+reg owner = 1'b0;       // Hart with its access in the memory unit
+
+assign h0Grant_o = h0Req_i && (!h1Req_i || last);
+assign h1Grant_o = h1Req_i && !h0Grant_o;
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                last  <= 1'b1;
+                owner <= 1'b0;
+        end else begin
+                if (h0Grant_o || h1Grant_o)
+                        last <= h1Grant_o;
+                owner <= h1Grant_o;
+        end
+end
+
+assign IO_memAddr_o  = owner ? h1Addr_i  : h0Addr_i;
+assign IO_memWData_o = owner ? h1WData_i : h0WData_i;
+assign IO_memWr_o    = owner ? h1Wr_i    : h0Wr_i;
+
+assign h0RData_o = owner ? 32'b0 : IO_memRData_i;
+assign h1RData_o = owner ? IO_memRData_i : 32'b0;
+
+endmodule
@@ -0,0 +1,183 @@
+/*************************************************
+ *File----------MemArbiter.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 03:06:51 UTC
+ ************************************************/
+/* verilator lint_off WIDTH */
+
+module MemArbiter #(
+        parameter SNOOP = 1             // Snoop the other cache before a refill
+)(
+        input  wire        clk_i,
+        input  wire        reset_i,
+        // Cache 0
+        input  wire        m0ReqValid_i,
+        output wire        m0ReqReady_o,
+        input  wire        m0ReqWrite_i,
+        input  wire [31:0] m0ReqAddr_i,
+        input  wire [7:0]  m0ReqLen_i,
+        input  wire        m0WValid_i,
+        output wire        m0WReady_o,
+        input  wire [31:0] m0WData_i,
+        output wire        m0RespValid_o,
+        output wire [31:0] m0RespData_o,
+        output wire        m0SnoopValid_o,
+        output wire [31:0] m0SnoopAddr_o,
+        input  wire        m0SnoopAck_i,
+        // Cache 1
+        input  wire        m1ReqValid_i,
+        output wire        m1ReqReady_o,
+        input  wire        m1ReqWrite_i,
+        input  wire [31:0] m1ReqAddr_i,
+        input  wire [7:0]  m1ReqLen_i,
+        input  wire        m1WValid_i,
+        output wire        m1WReady_o,
+        input  wire [31:0] m1WData_i,
+        output wire        m1RespValid_o,
+        output wire [31:0] m1RespData_o,
+        output wire        m1SnoopValid_o,
+        output wire [31:0] m1SnoopAddr_o,
+        input  wire        m1SnoopAck_i,
+        // Memory
+        output wire        memReqValid_o,
+        input  wire        memReqReady_i,
+        output wire        memReqWrite_o,
+        output wire [31:0] memReqAddr_o,
+        output wire [7:0]  memReqLen_o,
+        output wire        memWValid_o,
+        input  wire        memWReady_i,
+        output wire [31:0] memWData_o,
+        input  wire        memRespValid_i,
+        input  wire [31:0] memRespData_i
+);
+
+/*
+ * Shares one burst port between two caches, round robin between requests.
+ * A burst keeps the port until its last word is transferred.
+ * With SNOOP set a refill (read) is only granted after the other cache has
+ * given up the line. While it waits, write backs from the other cache are
+ * let through, since the snooped line or the victim of a waiting refill may
+ * need to reach memory first.
+ */
+
+localparam A_IDLE  = 2'd0;
+localparam A_SNOOP = 2'd1;
+localparam A_BUSY  = 2'd2;
+
+reg [1:0]  state = A_IDLE;
+reg        owner = 1'b0;        // Cache holding the port
+reg        last = 1'b1;         // Last cache granted
+reg        fwd;                 // Request not yet accepted by memory
+reg        write;
+reg [7:0]  count;               // Words left in the burst
+reg        snoopFor;            // Cache waiting on the snoop
+reg        snoopDone;
+reg        resume;              // Return to the snoop after this burst
+
+/*verilator public_flat_rw_on*/
+reg [31:0] snoopCount = 0;      // Refills that snooped the other cache
+reg [31:0] snoopWaitCycles = 0; // Cycles refills waited on a snoop
+/*verilator public_off*/
+
+wire [1:0] reqValid = {m1ReqValid_i, m0ReqValid_i};
+wire [1:0] reqWrite = {m1ReqWrite_i, m0ReqWrite_i};
+wire [7:0] reqLen0  = m0ReqLen_i;
+wire [7:0] reqLen1  = m1ReqLen_i;
+
+// Take turns when both request
+wire pick = (reqValid == 2'b11) ? ~last : reqValid[1];
+
+wire other = ~snoopFor;
+wire otherAck = other ? m1SnoopAck_i : m0SnoopAck_i;
+wire otherWrite = reqValid[other] && reqWrite[other];
+
+/*--------------------MEMORY PORT-----------------*/
+wire busy = (state == A_BUSY);
+
+assign memReqValid_o = busy && fwd && (owner ? m1ReqValid_i : m0ReqValid_i);
+assign memReqWrite_o = owner ? m1ReqWrite_i : m0ReqWrite_i;
+assign memReqAddr_o  = owner ? m1ReqAddr_i  : m0ReqAddr_i;
+assign memReqLen_o   = owner ? m1ReqLen_i   : m0ReqLen_i;
+assign memWValid_o   = busy && !fwd && write && (owner ? m1WValid_i : m0WValid_i);
+assign memWData_o    = owner ? m1WData_i : m0WData_i;
+
+assign m0ReqReady_o  = busy && fwd && !owner && memReqReady_i;
+assign m1ReqReady_o  = busy && fwd &&  owner && memReqReady_i;
+assign m0WReady_o    = busy && !fwd && write && !owner && memWReady_i;
+assign m1WReady_o    = busy && !fwd && write &&  owner && memWReady_i;
+assign m0RespValid_o = busy && !write && !owner && memRespValid_i;
+assign m1RespValid_o = busy && !write &&  owner && memRespValid_i;
+assign m0RespData_o  = memRespData_i;
+assign m1RespData_o  = memRespData_i;
+
+/*----------------------SNOOP---------------------*/
+wire snooping = SNOOP && (state == A_SNOOP) && !snoopDone;
+assign m0SnoopValid_o = snooping &&  snoopFor;
+assign m1SnoopValid_o = snooping && !snoopFor;
+assign m0SnoopAddr_o  = m1ReqAddr_i;
+assign m1SnoopAddr_o  = m0ReqAddr_i;
+
+wire beat = write ? (memWValid_o && memWReady_i) : memRespValid_i;
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                state <= A_IDLE;
+                resume <= 1'b0;
+        end else begin
+                case (state)
+                A_IDLE: if (reqValid != 2'b00) begin
+                        if (!SNOOP || reqWrite[pick]) begin
+                                state  <= A_BUSY;
+                                owner  <= pick;
+                                last   <= pick;
+                                fwd    <= 1'b1;
+                                write  <= reqWrite[pick];
+                                count  <= pick ? reqLen1 : reqLen0;
+                                resume <= 1'b0;
+                        end else begin
+                                state     <= A_SNOOP;
+                                snoopFor  <= pick;
+                                snoopDone <= 1'b0;
+                                snoopCount <= snoopCount + 1;
+                        end
+                end
+                A_SNOOP: begin
+                        if (snoopDone || otherAck) begin
+                                state  <= A_BUSY;
+                                owner  <= snoopFor;
+                                last   <= snoopFor;
+                                fwd    <= 1'b1;
+                                write  <= 1'b0;
+                                count  <= snoopFor ? reqLen1 : reqLen0;
+                                resume <= 1'b0;
+                        end else if (otherWrite) begin
+                                state  <= A_BUSY;
+                                owner  <= other;
+                                fwd    <= 1'b1;
+                                write  <= 1'b1;
+                                count  <= other ? reqLen1 : reqLen0;
+                                resume <= 1'b1;
+                        end
+                        snoopWaitCycles <= snoopWaitCycles + 1;
+                end
+                A_BUSY: begin
+                        if (fwd && memReqReady_i)
+                                fwd <= 1'b0;
+                        if (!fwd && beat) begin
+                                count <= count - 1;
+                                if (count == 1)
+                                        state <= resume ? A_SNOOP : A_IDLE;
+                        end
+                        // A dirty snooped line finishes with its last write
+                        if (resume && otherAck)
+                                snoopDone <= 1'b1;
+                end
+                default: state <= A_IDLE;
+                endcase
+        end
+end
+
+endmodule
+/* verilator lint_on WIDTH */
@@ -9,13 +9,24 @@
 
 module Memory (
         input  wire        clk_i,
-        input  wire [31:0] IMemAddr_i,
-        output wire [31:0] IMemData_o,
-        input  wire [31:0] DMemRAddr_i,
-        output wire [63:0] DMemRData_o,
-        input  wire [31:0] DMemWAddr_i,
-        input  wire [63:0] DMemWData_i,
-        input  wire [4:0]  DMemWMask_i
+        // Instruction Cache Refill Port
+        input  wire        IMemReqValid_i,
+        output wire        IMemReqReady_o,
+        input  wire [31:0] IMemReqAddr_i,
+        input  wire [7:0]  IMemReqLen_i,
+        output wire        IMemRespValid_o,
+        output wire [31:0] IMemRespData_o,
+        // Data Cache Refill/Writeback Port
+        input  wire        DMemReqValid_i,
+        output wire        DMemReqReady_o,
+        input  wire        DMemReqWrite_i,
+        input  wire [31:0] DMemReqAddr_i,
+        input  wire [7:0]  DMemReqLen_i,
+        input  wire        DMemWValid_i,
+        output wire        DMemWReady_o,
+        input  wire [31:0] DMemWData_i,
+        output wire        DMemRespValid_o,
+        output wire [31:0] DMemRespData_o
 );
 
 reg [15:0] INSTMEM [0:32767];
@@ -26,23 +37,108 @@ initial begin
         $readmemh("../bin/RAM.hex",DATAMEM);
 end
 
-// Instruction ROM: Can be alligned to 16 bits or 32 bits
-wire [15:0] IMemdata_1 = INSTMEM[IMemAddr_i[31:1]];
-wire [15:0] IMemdata_2 = INSTMEM[IMemAddr_i[31:1] + 1];
-assign IMemData_o = {IMemdata_2, IMemdata_1};
+`ifdef BENCH
+// DRAM timing model (tb/dramsim.cpp). Returns the cycles until the first
+// word of a burst and keeps the bank and bus state of the simulated DRAM
+import "DPI-C" function int dram_access(input int cycle, input int port,
+        input int write, input int addr, input int len);
 
-// Data RAM: All alligned to 32 bits
-wire [31:0] DMemRData_1 = DATAMEM[DMemRAddr_i[31:2]];
-wire [31:0] DMemRData_2 = DATAMEM[DMemRAddr_i[31:2] + 1];
-assign DMemRData_o = {DMemRData_2, DMemRData_1};
+reg [31:0] cycle = 0;
+always @(posedge clk_i) begin
+        cycle <= cycle + 1;
+end
+`endif
+
+// Instruction ROM: Burst reads of IMemReqLen_i words (a power of 2) starting
+// at the requested word and wrapping around the aligned block. One word per cycle
+// after IWait cycles of DRAM latency (none outside of simulation)
+reg        IBusy = 1'b0;
+reg [15:0] IWait;
+reg [29:0] IWordAddr;
+reg [29:0] ILenMask;
+reg [7:0]  ICount;
+reg        IRespValid = 1'b0;
+reg [31:0] IRespData;
+
+assign IMemReqReady_o  = !IBusy;
+assign IMemRespValid_o = IRespValid;
+assign IMemRespData_o  = IRespData;
+
+always @(posedge clk_i) begin
+        IRespValid <= 1'b0;
+        if (!IBusy && IMemReqValid_i) begin
+                IBusy     <= 1'b1;
+                IWordAddr <= IMemReqAddr_i[31:2];
+                ILenMask  <= IMemReqLen_i - 1;
+                ICount    <= IMemReqLen_i;
+`ifdef BENCH
+                IWait     <= dram_access(cycle, 0, 0, IMemReqAddr_i, IMemReqLen_i) - 1;
+`else
+                IWait     <= 0;
+`endif
+        end else if (IBusy && (IWait != 0)) begin
+                IWait <= IWait - 1;
+        end else if (IBusy) begin
+                IRespValid <= 1'b1;
+                IRespData  <= {INSTMEM[{IWordAddr, 1'b1}], INSTMEM[{IWordAddr, 1'b0}]};
+                IWordAddr  <= (IWordAddr & ~ILenMask) | ((IWordAddr + 1) & ILenMask);
+                ICount     <= ICount - 1;
+                if (ICount == 1)
+                        IBusy <= 1'b0;
+        end
+end
+
+// Data RAM: Burst reads and writes of DMemReqLen_i words (a power of 2)
+// wrapping around the aligned block. One word per cycle after DWait cycles of
+// DRAM latency. Writes are posted, so only reads wait
+reg        DBusy = 1'b0;
+reg [15:0] DWait;
+`ifdef BENCH
+integer    DLatency;
+`endif
+reg        DWrite;
+reg [29:0] DWordAddr;
+reg [29:0] DLenMask;
+reg [7:0]  DCount;
+reg        DRespValid = 1'b0;
+reg [31:0] DRespData;
+
+assign DMemReqReady_o  = !DBusy;
+assign DMemWReady_o    = DBusy & DWrite & (DWait == 0);
+assign DMemRespValid_o = DRespValid;
+assign DMemRespData_o  = DRespData;
+
+wire       DStep = DBusy & (DWait == 0) & (!DWrite | DMemWValid_i);
 
-wire [29:0] wordAddr = DMemWAddr_i[31:2];
 always @(posedge clk_i) begin
-        if (DMemWMask_i[0]) DATAMEM[wordAddr][ 7:0 ] <= DMemWData_i[ 7:0 ];
-        if (DMemWMask_i[1]) DATAMEM[wordAddr][15:8 ] <= DMemWData_i[15:8 ];
-        if (DMemWMask_i[2]) DATAMEM[wordAddr][23:16] <= DMemWData_i[23:16];
-        if (DMemWMask_i[3]) DATAMEM[wordAddr][31:24] <= DMemWData_i[31:24];
-        if (DMemWMask_i[4]) DATAMEM[wordAddr + 1]    <= DMemWData_i[63:32];
+        DRespValid <= 1'b0;
+        if (!DBusy && DMemReqValid_i) begin
+                DBusy     <= 1'b1;
+                DWrite    <= DMemReqWrite_i;
+                DWordAddr <= DMemReqAddr_i[31:2];
+                DLenMask  <= DMemReqLen_i - 1;
+                DCount    <= DMemReqLen_i;
+`ifdef BENCH
+                DLatency   = dram_access(cycle, 1, DMemReqWrite_i, DMemReqAddr_i,
+                                DMemReqLen_i);
+                DWait     <= DMemReqWrite_i ? 0 : DLatency - 1;
+`else
+                DWait     <= 0;
+`endif
+        end else if (DBusy && (DWait != 0)) begin
+                DWait <= DWait - 1;
+        end else if (DStep) begin
+                if (DWrite) begin
+                        DATAMEM[DWordAddr] <= DMemWData_i;
+                end else begin
+                        DRespValid <= 1'b1;
+                        DRespData  <= DATAMEM[DWordAddr];
+                end
+                DWordAddr <= (DWordAddr & ~DLenMask) | ((DWordAddr + 1) & DLenMask);
+                DCount    <= DCount - 1;
+                if (DCount == 1)
+                        DBusy <= 1'b0;
+        end
 end
 
 endmodule
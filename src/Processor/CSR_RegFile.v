@@ -6,7 +6,10 @@
  *Created-------Monday Nov 24, 2025 20:27:50 UTC
  ************************************************/
 
-module CSR_RegFile (
+module CSR_RegFile #(
+        parameter HPM_COUNTERS = 4,     // mhpmcounter3 - mhpmcounter(3+N-1), up to 29
+        parameter HARTID = 0            // mhartid
+)(
         input  wire        clk_i,
         input  wire        reset_i,
         // Write
@@ -18,6 +21,14 @@ module CSR_RegFile (
         output wire [31:0] csrRData_o,
         // Instret update
         input wire         csrInstStep_i,
+        input wire         csrInstFused_i,  // Retired instruction is a fused pair
+        input wire         csrInstStep2_i,  // Second issue lane retired an instruction
+        // Performance counter events, bit N is event N (bit 0 unused)
+        input  wire [15:0] csrHpmEvents_i,
+        // CLINT interrupt lines, read only in mip
+        input  wire        timerIrq_i,      // MTIP
+        input  wire        softIrq_i,       // MSIP
+        input  wire [63:0] mtime_i,         // time CSR, compared with stimecmp
         // FPU Rounding Mode and flags
         input  wire [4:0]  csrFFlagsSet_i,
         output wire [2:0]  csrFRM_o,
@@ -28,16 +39,23 @@ module CSR_RegFile (
         output wire [31:0] csrMtvec_o,
         output wire [31:0] csrMepc_o,
         output wire [31:0] csrMCause_o,
+        output wire [31:0] csrMtval_o,
+        output wire [31:0] csrMip_o,
+        output wire [31:0] csrMie_o,
         // Supervisor Mode CSRs
         output wire [31:0] csrStvec_o,
         output wire [31:0] csrSepc_o,
         output wire [31:0] csrSCause_o,
+        output wire [31:0] csrStval_o,
+        output wire [31:0] csrSatp_o,
         // Set Trap CSRs
         input  wire [6:0]  csrMStatusSet_i, // {MPP[1:0], MPIE, MIE, SPP, SPIE, SIE}
         input  wire [31:0] csrMepcSet_i,
         input  wire [31:0] csrMCauseSet_i,
+        input  wire [31:0] csrMtvalSet_i,
         input  wire [31:0] csrSepcSet_i,
         input  wire [31:0] csrSCauseSet_i,
+        input  wire [31:0] csrStvalSet_i,
         input  wire        csrTrapSetEn_i
 );
 
@@ -45,6 +63,27 @@ module CSR_RegFile (
 reg [63:0] CSR_cycle = 0;   // 0xC00 / 0xC80 ([31:0] / [63:32])
 reg [63:0] CSR_instret = 0; // 0xC02 / 0xC82 ([31:0] / [63:32]) 
 
+/*
+ * Hardware performance monitor (Zihpm, Sscofpmf)
+ * mhpmcounter3+ count the event selected by mhpmevent3+[3:0]:
+ *   0: None
+ *   1: Branch mispredicts
+ *   2: JALR mispredicts
+ *   3: Data hazard stall cycles (MUL-use, load after store)
+ *   4: Long latency stall cycles (waiting on DIV/FDIV/FSQRT/FP pipe results)
+ *   5: Execute busy cycles (divider/FPU occupied, long op writeback)
+ *   6: CSR hazard stall cycles (CSR write in execute that is not forwarded)
+ *   7: Instruction cache miss cycles
+ *   8: Data cache stall cycles (load miss, store buffer full, FENCE, IO port)
+ * A counter that wraps to 0 sets its OF bit (mhpmeventh[31]) and raises the
+ * local counter overflow interrupt (LCOFIP, mip[13]) if OF was clear.
+ * mcountinhibit stops cycle (bit 0), instret (bit 2) and mhpmcounterN (bit N).
+ */
+reg [63:0] CSR_mhpmcounter [3:HPM_COUNTERS+2];  // 0xB03+ / 0xB83+ (0xC03+ / 0xC83+ read only)
+reg [3:0]  CSR_mhpmevent   [3:HPM_COUNTERS+2];  // 0x323+
+reg [31:0] CSR_mhpmOF = 0;                      // 0x723+ [31] OF bits, 0xDA0 scountovf
+reg [31:0] CSR_mcountinhibit = 0;               // 0x320
+
 // Floating Point Extension
 reg [31:0] CSR_fcsr = 0;    // 0x001 - 0x003 (fflags, frm, fcsr)
 
@@ -57,6 +96,21 @@ reg [31:0] CSR_mtvec    = 0;
 reg [31:0] CSR_mepc     = 0;
 reg [31:0] CSR_mcause   = 0;
 reg [31:0] CSR_mscratch = 0;
+reg [31:0] CSR_mtval    = 0;
+reg [31:0] CSR_mip      = 0;
+reg [31:0] CSR_mie      = 0;
+reg [31:0] CSR_menvcfgh = 0;    // [31] STCE enables stimecmp
+
+/*
+ * Supervisor timer (Sstc)
+ * With menvcfg.STCE set, mip.STIP is mtime >= stimecmp and S mode reprograms
+ * its timer with a CSR write instead of an SBI call. With STCE clear, STIP is
+ * written by M mode. The compare is registered, so STIP follows a stimecmp
+ * write a cycle after it leaves the memory unit, before an SRET behind it
+ * reaches decode.
+ */
+reg [63:0] CSR_stimecmp = {64{1'b1}};
+reg        CSR_stip     = 0;
 
 // Supervisor Mode CSRs
 // sstatus CSR is subset of mstatus CSR
@@ -64,12 +118,26 @@ reg [31:0] CSR_stvec    = 0;
 reg [31:0] CSR_sepc     = 0;
 reg [31:0] CSR_scause   = 0;
 reg [31:0] CSR_sscratch = 0;
+reg [31:0] CSR_stval    = 0;
+reg [31:0] CSR_satp     = 0;    // {MODE, ASID[8:0], PPN[21:0]}
 
 // Register IDs
 localparam CYCLE_ID      = 12'hC00;
 localparam CYCLEH_ID     = 12'hC80;
 localparam INSTRET_ID    = 12'hC02;
 localparam INSTRETH_ID   = 12'hC82;
+localparam MCYCLE_ID     = 12'hB00;
+localparam MCYCLEH_ID    = 12'hB80;
+localparam MINSTRET_ID   = 12'hB02;
+localparam MINSTRETH_ID  = 12'hB82;
+localparam MCOUNTINH_ID  = 12'h320;
+localparam SCOUNTOVF_ID  = 12'hDA0;
+localparam MHARTID_ID    = 12'hF14;
+localparam TIME_ID       = 12'hC01;
+localparam TIMEH_ID      = 12'hC81;
+localparam HPM_LAST      = HPM_COUNTERS + 2;
+localparam HPM_MASK      = ((32'b1 << (HPM_COUNTERS + 3)) - 1) & ~32'b111;
+localparam MCOUNTINH_MASK = HPM_MASK | 32'b101;
 
 localparam FFLAGS_ID     = 12'h001;
 localparam FRM_ID        = 12'h002;
@@ -87,6 +155,15 @@ localparam MTVEC_ID      = 12'h305;
 localparam MSCRATCH_ID   = 12'h340;
 localparam MEPC_ID       = 12'h341;
 localparam MCAUSE_ID     = 12'h342;
+localparam MTVAL_ID      = 12'h343;
+localparam MIE_ID        = 12'h304;
+localparam MIP_ID        = 12'h344;
+localparam MENVCFG_ID    = 12'h30A;
+localparam MENVCFGH_ID   = 12'h31A;
+localparam MIP_MASK      = 32'h00002020;        // LCOFIP, STIP (MTIP and MSIP come from the CLINT)
+localparam MIE_MASK      = 32'h000020A8;        // LCOFIE, MTIE, STIE, MSIE
+localparam MIDELEG_MASK  = 32'h00002020;        // Only LCOFI and STI can be delegated
+localparam MENVCFGH_MASK = 32'h80000000;        // STCE
 localparam MSTATUS_MASK  = 32'h81FFFFEA;
 localparam MSTATUSH_MASK = 32'h000006F0;
 
@@ -95,8 +172,73 @@ localparam STVEC_ID      = 12'h105;
 localparam SSCRATCH_ID   = 12'h140;
 localparam SEPC_ID       = 12'h141;
 localparam SCAUSE_ID     = 12'h142;
+localparam STVAL_ID      = 12'h143;
+localparam SATP_ID       = 12'h180;
+localparam SIE_ID        = 12'h104;
+localparam SIP_ID        = 12'h144;
+localparam SIP_MASK      = 32'h00002000;        // STIP is read only in sip
+localparam STIMECMP_ID   = 12'h14D;
+localparam STIMECMPH_ID  = 12'h15D;
 localparam SSTATUS_MASK  = 32'h818DE762;
 
+// Performance counter selected by a CSR address (0 if none)
+function [4:0] hpmIndex;
+        input [11:0] addr;
+        begin
+                hpmIndex = ((addr[4:0] >= 3) && (addr[4:0] <= HPM_LAST)) ? addr[4:0] : 5'd0;
+        end
+endfunction
+
+wire [4:0] hpmRIdx = hpmIndex(csrRAddr_i);
+wire [4:0] hpmWIdx = hpmIndex(csrWAddr_i);
+
+/*
+ * Write forwarding
+ * CSRs are written by the memory unit. The trap CSRs and the scratch registers
+ * are forwarded from that write to the read port (execute) and to the trap
+ * logic (decode), so neither has to wait for the write to commit.
+ * satp is forwarded to the MMU, so the refetch after a satp write and a load or
+ * store right behind it are translated with the new value.
+ */
+function written;
+        input [11:0] id;
+        begin
+                written = csrWEnable_i && (csrWAddr_i == id);
+        end
+endfunction
+
+wire [31:0] fwd_mstatus  = written(MSTATUS_ID)  ? csrWData_i & MSTATUS_MASK :
+                           written(SSTATUS_ID)  ? csrWData_i & SSTATUS_MASK : CSR_mstatus;
+wire [31:0] fwd_mstatush = written(MSTATUSH_ID) ? csrWData_i & MSTATUSH_MASK : CSR_mstatush;
+wire [63:0] fwd_medeleg  = {written(MEDELEGH_ID) ? csrWData_i : CSR_medeleg[63:32],
+                            written(MEDELEG_ID)  ? csrWData_i : CSR_medeleg[31:0]};
+wire [31:0] fwd_mideleg  = written(MIDELEG_ID)  ? csrWData_i & MIDELEG_MASK : CSR_mideleg;
+wire [31:0] fwd_mtvec    = written(MTVEC_ID)    ? csrWData_i : CSR_mtvec;
+wire [31:0] fwd_mscratch = written(MSCRATCH_ID) ? csrWData_i : CSR_mscratch;
+wire [31:0] fwd_mepc     = written(MEPC_ID)     ? csrWData_i : CSR_mepc;
+wire [31:0] fwd_mcause   = written(MCAUSE_ID)   ? csrWData_i : CSR_mcause;
+wire [31:0] fwd_mtval    = written(MTVAL_ID)    ? csrWData_i : CSR_mtval;
+wire [31:0] fwd_mie      = written(MIE_ID)      ? csrWData_i & MIE_MASK :
+                           written(SIE_ID)      ? (CSR_mie & ~CSR_mideleg) |
+                                                  (csrWData_i & MIE_MASK & CSR_mideleg) : CSR_mie;
+// STIP is only written by M mode while stimecmp does not drive it
+wire        stce         = CSR_menvcfgh[31];
+wire [31:0] mipWMask     = stce ? (MIP_MASK & ~32'h00000020) : MIP_MASK;
+wire [31:0] fwd_mipSw    = written(MIP_ID)      ? (CSR_mip & ~mipWMask) | (csrWData_i & mipWMask) :
+                           written(SIP_ID)      ? (CSR_mip & ~(SIP_MASK & CSR_mideleg)) |
+                                                  (csrWData_i & SIP_MASK & CSR_mideleg) : CSR_mip;
+wire [31:0] fwd_menvcfgh = written(MENVCFGH_ID) ? csrWData_i & MENVCFGH_MASK : CSR_menvcfgh;
+wire [63:0] fwd_stimecmp = {written(STIMECMPH_ID) ? csrWData_i : CSR_stimecmp[63:32],
+                            written(STIMECMP_ID)  ? csrWData_i : CSR_stimecmp[31:0]};
+wire [31:0] fwd_mip      = {fwd_mipSw[31:6], stce ? CSR_stip : fwd_mipSw[5], fwd_mipSw[4:0]} |
+                           {24'b0, timerIrq_i, 3'b0, softIrq_i, 3'b0};
+wire [31:0] fwd_stvec    = written(STVEC_ID)    ? csrWData_i : CSR_stvec;
+wire [31:0] fwd_sscratch = written(SSCRATCH_ID) ? csrWData_i : CSR_sscratch;
+wire [31:0] fwd_sepc     = written(SEPC_ID)     ? csrWData_i : CSR_sepc;
+wire [31:0] fwd_scause   = written(SCAUSE_ID)   ? csrWData_i : CSR_scause;
+wire [31:0] fwd_stval    = written(STVAL_ID)    ? csrWData_i : CSR_stval;
+wire [31:0] fwd_satp     = written(SATP_ID)     ? csrWData_i : CSR_satp;
+
 // CSR Read
 reg [31:0] rData;
 always @(*) begin
@@ -107,39 +249,79 @@ always @(*) begin
                 CYCLEH_ID:   rData = CSR_cycle[63:32];
                 INSTRET_ID:  rData = CSR_instret[31:0];
                 INSTRETH_ID: rData = CSR_instret[63:32];
+                MHARTID_ID:  rData = HARTID;
+                TIME_ID:     rData = mtime_i[31:0];
+                TIMEH_ID:    rData = mtime_i[63:32];
                 FFLAGS_ID:   rData = {27'b0, csrWData_i[4:0]};
                 FRM_ID:      rData = {29'b0, csrWData_i[7:5]};
                 FCSR_ID:     rData = {24'b0, csrWData_i[7:0]};
 
-                MSTATUS_ID:  rData = CSR_mstatus  & MSTATUS_MASK;
-                MSTATUSH_ID: rData = CSR_mstatush & MSTATUSH_MASK;
-                MEDELEG_ID:  rData = CSR_medeleg[31:0];
-                MEDELEGH_ID: rData = CSR_medeleg[63:32];
-                MIDELEG_ID:  rData = CSR_mideleg;
-                MTVEC_ID:    rData = CSR_mtvec;
-                MSCRATCH_ID: rData = CSR_mscratch;
-                MEPC_ID:     rData = CSR_mepc;
-                MCAUSE_ID:   rData = CSR_mcause;
-
-                SSTATUS_ID:  rData = CSR_mstatus & SSTATUS_MASK;
-                STVEC_ID:    rData = CSR_stvec;
-                SSCRATCH_ID: rData = CSR_sscratch;
-                SEPC_ID:     rData = CSR_sepc;
-                SCAUSE_ID:   rData = CSR_scause;
+                MSTATUS_ID:  rData = fwd_mstatus  & MSTATUS_MASK;
+                MSTATUSH_ID: rData = fwd_mstatush & MSTATUSH_MASK;
+                MEDELEG_ID:  rData = fwd_medeleg[31:0];
+                MEDELEGH_ID: rData = fwd_medeleg[63:32];
+                MIDELEG_ID:  rData = fwd_mideleg;
+                MTVEC_ID:    rData = fwd_mtvec;
+                MSCRATCH_ID: rData = fwd_mscratch;
+                MEPC_ID:     rData = fwd_mepc;
+                MCAUSE_ID:   rData = fwd_mcause;
+                MTVAL_ID:    rData = fwd_mtval;
+                MENVCFG_ID:  rData = 32'b0;
+                MENVCFGH_ID: rData = fwd_menvcfgh;
+
+                SSTATUS_ID:  rData = fwd_mstatus & SSTATUS_MASK;
+                STVEC_ID:    rData = fwd_stvec;
+                SSCRATCH_ID: rData = fwd_sscratch;
+                SEPC_ID:     rData = fwd_sepc;
+                SCAUSE_ID:   rData = fwd_scause;
+                STVAL_ID:    rData = fwd_stval;
+                SATP_ID:     rData = fwd_satp;
+                STIMECMP_ID: rData = fwd_stimecmp[31:0];
+                STIMECMPH_ID: rData = fwd_stimecmp[63:32];
+
+                MCYCLE_ID:    rData = CSR_cycle[31:0];
+                MCYCLEH_ID:   rData = CSR_cycle[63:32];
+                MINSTRET_ID:  rData = CSR_instret[31:0];
+                MINSTRETH_ID: rData = CSR_instret[63:32];
+                MCOUNTINH_ID: rData = CSR_mcountinhibit;
+                SCOUNTOVF_ID: rData = CSR_mhpmOF & HPM_MASK;
+                MIE_ID:       rData = fwd_mie;
+                MIP_ID:       rData = fwd_mip;
+                SIE_ID:       rData = fwd_mie & fwd_mideleg;
+                SIP_ID:       rData = fwd_mip & fwd_mideleg;
                 default:     rData = 32'b0;
         endcase
+
+        if (hpmRIdx != 0) begin
+                case (csrRAddr_i[11:5])
+                        7'b1011000, 7'b1100000: // mhpmcounterN, hpmcounterN
+                                rData = CSR_mhpmcounter[hpmRIdx][31:0];
+                        7'b1011100, 7'b1100100: // mhpmcounterNh, hpmcounterNh
+                                rData = CSR_mhpmcounter[hpmRIdx][63:32];
+                        7'b0011001:             // mhpmeventN
+                                rData = {28'b0, CSR_mhpmevent[hpmRIdx]};
+                        7'b0111001:             // mhpmeventNh
+                                rData = {CSR_mhpmOF[hpmRIdx], 31'b0};
+                        default:;
+                endcase
+        end
 end
 assign csrRData_o   = rData;
-assign csrMStatus_o = {CSR_mstatush, CSR_mstatus};
-assign csrMedeleg_o = CSR_medeleg;
-assign csrMideleg_o = CSR_mideleg;
-assign csrMtvec_o   = CSR_mtvec;
-assign csrMepc_o    = CSR_mepc;
-assign csrMCause_o  = CSR_mcause;
+assign csrMStatus_o = {fwd_mstatush, fwd_mstatus};
+assign csrMedeleg_o = fwd_medeleg;
+assign csrMideleg_o = fwd_mideleg;
+assign csrMtvec_o   = fwd_mtvec;
+assign csrMepc_o    = fwd_mepc;
+assign csrMCause_o  = fwd_mcause;
+assign csrMtval_o   = fwd_mtval;
+assign csrMip_o     = fwd_mip;
+assign csrMie_o     = fwd_mie;
 
-assign csrStvec_o   = CSR_stvec;
-assign csrSepc_o    = CSR_sepc;
-assign csrSCause_o  = CSR_scause;
+assign csrStvec_o   = fwd_stvec;
+assign csrSepc_o    = fwd_sepc;
+assign csrSCause_o  = fwd_scause;
+assign csrStval_o   = fwd_stval;
+assign csrSatp_o    = fwd_satp;
 
 // CSR Write
 always @(posedge clk_i) begin
@@ -153,46 +335,72 @@ always @(posedge clk_i) begin
                 CSR_mscratch       <= 32'b0;
                 CSR_mepc           <= 32'b0;
                 CSR_mcause         <= 32'b0;
+                CSR_mtval          <= 32'b0;
                 CSR_mstatus        <= 32'b0;
                 CSR_stvec          <= 32'b0;
                 CSR_sscratch       <= 32'b0;
                 CSR_sepc           <= 32'b0;
                 CSR_scause         <= 32'b0;
-        end else if (csrTrapSetEn_i) begin
-                CSR_mstatus [12:11]     <= csrMStatusSet_i[6:5]; // MPP
-                CSR_mstatus [7]         <= csrMStatusSet_i[4];   // MPIE
-                CSR_mstatus [3]         <= csrMStatusSet_i[3];   // MIE
-                CSR_mstatus [8]         <= csrMStatusSet_i[2];   // SPP
-                CSR_mstatus [5]         <= csrMStatusSet_i[1];   // SPIE
-                CSR_mstatus [1]         <= csrMStatusSet_i[0];   // SPE
-
-                CSR_mepc                <= csrMepcSet_i;
-                CSR_mcause              <= csrMCauseSet_i;
-                CSR_sepc                <= csrSepcSet_i;
-                CSR_scause              <= csrSCauseSet_i;
-        end else if (csrWEnable_i) begin
-                case (csrWAddr_i)
-                        FFLAGS_ID:   CSR_fcsr     <= csrWData_i & FFLAGS_MASK;
-                        FRM_ID:      CSR_fcsr     <= csrWData_i & FRM_MASK;
-                        FCSR_ID:     CSR_fcsr     <= csrWData_i & FCSR_MASK;
-
-                        MSTATUS_ID:  CSR_mstatus  <= csrWData_i & MSTATUS_MASK;
-                        MSTATUSH_ID: CSR_mstatush <= csrWData_i & MSTATUSH_MASK;
-                        MEDELEG_ID:  CSR_medeleg  <= {CSR_medeleg[63:32], csrWData_i};
-                        MEDELEGH_ID: CSR_medeleg  <= {csrWData_i, CSR_medeleg[31:0]};
-                        MIDELEG_ID:  CSR_mideleg  <= csrWData_i;
-                        MTVEC_ID:    CSR_mtvec    <= csrWData_i;
-                        MSCRATCH_ID: CSR_mscratch <= csrWData_i;
-                        MEPC_ID:     CSR_mepc     <= csrWData_i;
-                        MCAUSE_ID:   CSR_mcause   <= csrWData_i;
-
-                        SSTATUS_ID:  CSR_mstatus  <= csrWData_i & SSTATUS_MASK;
-                        STVEC_ID:    CSR_stvec    <= csrWData_i;
-                        SSCRATCH_ID: CSR_sscratch <= csrWData_i;
-                        SEPC_ID:     CSR_sepc     <= csrWData_i;
-                        SCAUSE_ID:   CSR_scause   <= csrWData_i;
-                        default:;
-                endcase
+                CSR_stval          <= 32'b0;
+                CSR_satp           <= 32'b0;
+                CSR_mie            <= 32'b0;
+                CSR_menvcfgh       <= 32'b0;
+                CSR_stimecmp       <= {64{1'b1}};
+                CSR_stip           <= 1'b0;
+        end else begin
+                CSR_stip <= (mtime_i >= fwd_stimecmp);
+
+                if (csrWEnable_i) begin
+                        case (csrWAddr_i)
+                                FFLAGS_ID:   CSR_fcsr     <= csrWData_i & FFLAGS_MASK;
+                                FRM_ID:      CSR_fcsr     <= csrWData_i & FRM_MASK;
+                                FCSR_ID:     CSR_fcsr     <= csrWData_i & FCSR_MASK;
+
+                                MSTATUS_ID:  CSR_mstatus  <= csrWData_i & MSTATUS_MASK;
+                                MSTATUSH_ID: CSR_mstatush <= csrWData_i & MSTATUSH_MASK;
+                                MEDELEG_ID:  CSR_medeleg  <= {CSR_medeleg[63:32], csrWData_i};
+                                MEDELEGH_ID: CSR_medeleg  <= {csrWData_i, CSR_medeleg[31:0]};
+                                MIDELEG_ID:  CSR_mideleg  <= csrWData_i & MIDELEG_MASK;
+                                MTVEC_ID:    CSR_mtvec    <= csrWData_i;
+                                MSCRATCH_ID: CSR_mscratch <= csrWData_i;
+                                MEPC_ID:     CSR_mepc     <= csrWData_i;
+                                MCAUSE_ID:   CSR_mcause   <= csrWData_i;
+                                MTVAL_ID:    CSR_mtval    <= csrWData_i;
+                                MIE_ID:      CSR_mie      <= csrWData_i & MIE_MASK;
+                                MENVCFGH_ID: CSR_menvcfgh <= csrWData_i & MENVCFGH_MASK;
+                                SIE_ID:      CSR_mie      <= (CSR_mie & ~CSR_mideleg) |
+                                                             (csrWData_i & MIE_MASK & CSR_mideleg);
+
+                                SSTATUS_ID:  CSR_mstatus  <= csrWData_i & SSTATUS_MASK;
+                                STVEC_ID:    CSR_stvec    <= csrWData_i;
+                                SSCRATCH_ID: CSR_sscratch <= csrWData_i;
+                                SEPC_ID:     CSR_sepc     <= csrWData_i;
+                                SCAUSE_ID:   CSR_scause   <= csrWData_i;
+                                STVAL_ID:    CSR_stval    <= csrWData_i;
+                                SATP_ID:     CSR_satp     <= csrWData_i;
+                                STIMECMP_ID: CSR_stimecmp <= {CSR_stimecmp[63:32], csrWData_i};
+                                STIMECMPH_ID: CSR_stimecmp <= {csrWData_i, CSR_stimecmp[31:0]};
+                                default:;
+                        endcase
+                end
+
+                // Trap entry and return after the write. Decode computes the
+                // trap values from the forwarded CSRs, so both take effect
+                if (csrTrapSetEn_i) begin
+                        CSR_mstatus [12:11]     <= csrMStatusSet_i[6:5]; // MPP
+                        CSR_mstatus [7]         <= csrMStatusSet_i[4];   // MPIE
+                        CSR_mstatus [3]         <= csrMStatusSet_i[3];   // MIE
+                        CSR_mstatus [8]         <= csrMStatusSet_i[2];   // SPP
+                        CSR_mstatus [5]         <= csrMStatusSet_i[1];   // SPIE
+                        CSR_mstatus [1]         <= csrMStatusSet_i[0];   // SPE
+
+                        CSR_mepc                <= csrMepcSet_i;
+                        CSR_mcause              <= csrMCauseSet_i;
+                        CSR_mtval               <= csrMtvalSet_i;
+                        CSR_sepc                <= csrSepcSet_i;
+                        CSR_scause              <= csrSCauseSet_i;
+                        CSR_stval               <= csrStvalSet_i;
+                end
         end
         // Set FPU Flags
         CSR_fcsr[4:0] <= CSR_fcsr[4:0] | csrFFlagsSet_i;
@@ -204,9 +412,78 @@ always @(posedge clk_i) begin
                 CSR_cycle   <= 64'b0;
                 CSR_instret <= 64'b0;
         end else begin
-                CSR_cycle   <= CSR_cycle + 1'b1;
-                if (csrInstStep_i)
-                        CSR_instret <= CSR_instret + 1'b1;
+                if (!CSR_mcountinhibit[0])
+                        CSR_cycle   <= CSR_cycle + 1'b1;
+                if ((csrInstStep_i || csrInstStep2_i) && !CSR_mcountinhibit[2])
+                        CSR_instret <= CSR_instret + csrInstStep_i + csrInstFused_i +
+                                csrInstStep2_i;
+
+                if (csrWEnable_i) begin
+                        case (csrWAddr_i)
+                                MCYCLE_ID:    CSR_cycle   <= {CSR_cycle[63:32], csrWData_i};
+                                MCYCLEH_ID:   CSR_cycle   <= {csrWData_i, CSR_cycle[31:0]};
+                                MINSTRET_ID:  CSR_instret <= {CSR_instret[63:32], csrWData_i};
+                                MINSTRETH_ID: CSR_instret <= {csrWData_i, CSR_instret[31:0]};
+                                default:;
+                        endcase
+                end
+        end
+end
+
+// Performance Counters
+integer n;
+reg lcofSet;
+reg lcofSetLast = 1'b0;         // Raised while execute read mip for a write
+always @(posedge clk_i) begin
+        lcofSet = 1'b0;
+        if (reset_i) begin
+                CSR_mhpmOF        <= 32'b0;
+                CSR_mcountinhibit <= 32'b0;
+                CSR_mip           <= 32'b0;
+                lcofSetLast       <= 1'b0;
+                for (n = 3; n <= HPM_LAST; n = n + 1) begin
+                        CSR_mhpmcounter[n] <= 64'b0;
+                        CSR_mhpmevent[n]   <= 4'b0;
+                end
+        end else begin
+                for (n = 3; n <= HPM_LAST; n = n + 1) begin
+                        if (!CSR_mcountinhibit[n] && (CSR_mhpmevent[n] != 0) &&
+                                        csrHpmEvents_i[CSR_mhpmevent[n]]) begin
+                                CSR_mhpmcounter[n] <= CSR_mhpmcounter[n] + 1'b1;
+                                if (&CSR_mhpmcounter[n]) begin
+                                        CSR_mhpmOF[n] <= 1'b1;
+                                        if (!CSR_mhpmOF[n])
+                                                lcofSet = 1'b1;
+                                end
+                        end
+                end
+
+                // Software writes after the event update so they take effect
+                if (csrWEnable_i) begin
+                        case (csrWAddr_i)
+                                MCOUNTINH_ID: CSR_mcountinhibit <= csrWData_i & MCOUNTINH_MASK;
+                                MIP_ID:       CSR_mip <= (CSR_mip & ~mipWMask) |
+                                                         (csrWData_i & mipWMask);
+                                SIP_ID:       CSR_mip <= (CSR_mip & ~(SIP_MASK & CSR_mideleg)) |
+                                                         (csrWData_i & SIP_MASK & CSR_mideleg);
+                                default:;
+                        endcase
+                        if (hpmWIdx != 0) begin
+                                case (csrWAddr_i[11:5])
+                                        7'b1011000: CSR_mhpmcounter[hpmWIdx][31:0]  <= csrWData_i;
+                                        7'b1011100: CSR_mhpmcounter[hpmWIdx][63:32] <= csrWData_i;
+                                        7'b0011001: CSR_mhpmevent[hpmWIdx] <= csrWData_i[3:0];
+                                        7'b0111001: CSR_mhpmOF[hpmWIdx]    <= csrWData_i[31];
+                                        default:;
+                                endcase
+                        end
+                end
+
+                // A write to mip cannot clear an overflow raised in the same
+                // cycle, or in the cycle execute read the old mip for it
+                if (lcofSet || lcofSetLast)
+                        CSR_mip[13] <= 1'b1;
+                lcofSetLast <= lcofSet;
         end
 end
 
@@ -9,8 +9,6 @@
 module ControlUnit (
         input  wire HALT_i,
         input  wire dataHazard_i,
-        input  wire D_isPrivileged_i,
-        input  wire EM_isCSRWrite_i,
         input  wire aluBusy_i,
         input  wire E_correctPC_i,
         output wire F_stall_o,
@@ -21,14 +19,13 @@ module ControlUnit (
         output wire M_flush_o
 );
 
-wire csrHazard = D_isPrivileged_i & EM_isCSRWrite_i;
-
-assign F_stall_o = aluBusy_i | csrHazard | dataHazard_i | HALT_i;
-assign D_stall_o = aluBusy_i | csrHazard | dataHazard_i | HALT_i;
+assign F_stall_o = aluBusy_i | dataHazard_i | HALT_i;
+assign D_stall_o = aluBusy_i | dataHazard_i | HALT_i;
 assign E_stall_o = aluBusy_i;
 
-assign D_flush_o = E_correctPC_i;
-assign E_flush_o = E_correctPC_i | csrHazard | dataHazard_i;
+// Execute holds its instruction while stalled, so don't flush behind it
+assign D_flush_o = E_correctPC_i & !aluBusy_i;
+assign E_flush_o = (E_correctPC_i | dataHazard_i) & !aluBusy_i;
 assign M_flush_o = aluBusy_i;
 
 endmodule
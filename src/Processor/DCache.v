@@ -0,0 +1,466 @@
+/*************************************************
+ *File----------DCache.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Sunday Oct 18, 2026 22:26:48 UTC
+ ************************************************/
+/* verilator lint_off WIDTH */
+
+module DCache #(
+        parameter SIZE     = 4096,      // Bytes
+        parameter LINE     = 16,        // Bytes per line (at least 8)
+        parameter WAYS     = 2,         // Power of 2
+        parameter SB_DEPTH = 4          // Store buffer entries (power of 2)
+)(
+        input  wire        clk_i,
+        input  wire        reset_i,
+        // Read Port (Execute Unit)
+        input  wire [31:0] rAddr_i,
+        input  wire        rEnable_i,
+        input  wire        rDouble_i,       // Also read the next word (FLD)
+        output wire [63:0] rData_o,
+        output wire        rValid_o,
+        // Store Port (Memory Unit)
+        input  wire [31:0] wAddr_i,
+        input  wire [63:0] wData_i,
+        input  wire [4:0]  wMask_i,         // Bytes of the word, upper word
+        output wire        sbAlmostFull_o,  // No room for another store
+        output wire        sbEmpty_o,
+        // Prefetch Port
+        input  wire        pfValid_i,
+        input  wire [31:0] pfAddr_i,
+        output wire        pfReady_o,       // Request taken (refilled or already cached)
+        output wire        pfIssue_o,       // Request started a refill
+        output wire [2:0]  pfUseful_o,      // Demand accesses to prefetched lines
+        output wire        pfLate_o,        // Demand miss waiting on a prefetch
+        // Coherence (other data caches)
+        input  wire        snoopValid_i,    // Another cache is about to refill a line
+        input  wire [31:0] snoopAddr_i,
+        output wire        snoopAck_o,      // Line given up (written back if dirty)
+        input  wire        atomicLock_i,    // AMO reading in execute or in the memory unit
+        input  wire        wAtomic_i,       // Store is the write of an AMO/SC
+        // LR Reservation
+        input  wire [31:0] watchAddr_i,
+        output wire        watchLost_o,     // Line of watchAddr_i left the cache
+        // External Memory Interface
+        // A request transfers memReqLen_o words, starting at memReqAddr_o and
+        // wrapping around the aligned block. Writes send one word per
+        // memWValid_o/memWReady_i handshake after the request is accepted.
+        output wire        memReqValid_o,
+        input  wire        memReqReady_i,
+        output wire        memReqWrite_o,
+        output wire [31:0] memReqAddr_o,
+        output wire [7:0]  memReqLen_o,
+        output wire        memWValid_o,
+        input  wire        memWReady_i,
+        output wire [31:0] memWData_o,
+        input  wire        memRespValid_i,
+        input  wire [31:0] memRespData_i
+);
+
+/*
+ * Set associative write-back, write-allocate data cache with a combinational
+ * read, so a load that hits reads in the execute stage like the old data memory.
+ * Stores from the memory unit go into a store buffer and retire immediately.
+ * The buffer drains one word per cycle into the cache. Loads read the cache
+ * merged with any younger bytes still in the store buffer.
+ * One miss is handled at a time. A store miss at the head of the buffer
+ * refills its line in the background while loads that hit keep going.
+ * A load miss stalls execute until the words it needs have arrived.
+ * Prefetches refill a line when there is no demand miss. Prefetched lines are
+ * marked until their first demand access so the prefetcher can measure accuracy.
+ *
+ * With more than one core a line lives in at most one data cache. Before a
+ * refill is granted the memory arbiter snoops the other caches, which drop the
+ * line and write it back first if it is dirty. A snoop waits while an AMO or SC
+ * is between its read and the store buffer, so the pair stays atomic.
+ */
+
+localparam LINE_WORDS = LINE / 4;
+localparam SETS       = SIZE / (LINE * WAYS);
+localparam OFF_BITS   = $clog2(LINE);
+localparam WORD_BITS  = $clog2(LINE_WORDS);
+localparam SET_BITS   = $clog2(SETS);
+localparam TAG_BITS   = 32 - OFF_BITS - SET_BITS;
+localparam WAY_BITS   = (WAYS > 1) ? $clog2(WAYS) : 1;
+localparam SB_BITS    = $clog2(SB_DEPTH);
+
+reg [31:0]          data [0:WAYS*SETS*LINE_WORDS-1];
+reg [TAG_BITS-1:0]  tags [0:WAYS*SETS-1];
+reg [WAYS*SETS-1:0] lineValid = 0;
+reg [WAYS*SETS-1:0] lineDirty = 0;
+reg [WAYS*SETS-1:0] linePf = 0;         // Prefetched and not yet used
+reg [WAY_BITS-1:0]  victim = 0;         // Round robin replacement
+
+/*verilator public_flat_rw_on*/
+reg [31:0] loadHitCount = 0;            // Load/AMO reads that hit
+reg [31:0] loadMissCount = 0;           // Refills for a load
+reg [31:0] storeMissCount = 0;          // Refills for a store
+reg [31:0] writebackCount = 0;          // Dirty lines written back
+reg [31:0] missCycles = 0;              // Cycles execute waited on a load miss
+reg [31:0] sbFullCycles = 0;            // Cycles the store buffer had no room for a store
+reg [31:0] sbForwardCount = 0;          // Loads that took bytes from the store buffer
+reg [31:0] snoopCount = 0;              // Lines given up to another cache
+reg [31:0] snoopWbCount = 0;            // Dirty lines written back for another cache
+/*verilator public_off*/
+
+/*--------------------MISS HANDLING---------------*/
+localparam S_IDLE   = 2'd0;
+localparam S_WBACK  = 2'd1;
+localparam S_REFILL = 2'd2;
+
+reg [1:0]                state = S_IDLE;
+reg                      memReq = 1'b0;         // Request not yet accepted
+reg  [31-OFF_BITS:0]     mLine;                 // Line being refilled
+reg  [TAG_BITS-1:0]      mWbTag;                // Tag of the line written back
+reg  [WAY_BITS-1:0]      mWay;
+reg  [WORD_BITS-1:0]     mCrit;                 // Critical word
+reg  [WORD_BITS-1:0]     mWord;                 // Word of the next transfer
+reg  [WORD_BITS:0]       mCount;
+reg  [LINE_WORDS-1:0]    mWordValid;
+reg                      mPrefetch;             // Refill is a prefetch
+
+wire [SET_BITS-1:0] mSet = mLine[SET_BITS-1:0];
+
+/*--------------------STORE BUFFER----------------*/
+reg [29:0]          sbAddr [0:SB_DEPTH-1];      // Word address
+reg [31:0]          sbData [0:SB_DEPTH-1];
+reg [3:0]           sbMask [0:SB_DEPTH-1];
+reg [SB_DEPTH-1:0]  sbAtomic = 0;                // Write of an AMO/SC
+reg [SB_BITS-1:0]   sbHead = 0;
+reg [SB_BITS:0]     sbCount = 0;
+
+wire [SB_BITS-1:0]  sbTail = sbHead + sbCount;
+
+// Each store pushes one entry per written word
+wire        sbPushLo = |wMask_i[3:0];
+wire        sbPushHi = wMask_i[4];
+wire [1:0]  sbPushN  = sbPushLo + sbPushHi;
+wire [SB_BITS:0] sbFree = SB_DEPTH - sbCount - sbPushN;
+
+// A store in execute may push 2 entries once it reaches the memory unit
+assign sbAlmostFull_o = (sbFree < 2);
+assign sbEmpty_o = (sbCount == 0) && (sbPushN == 0);
+
+/*--------------------COHERENCE-------------------*/
+// AMOs wait for an empty store buffer, so an AMO write is always at the head.
+// Fills are held as well so the line cannot be evicted in the meantime.
+wire atomicHold = atomicLock_i || ((sbCount != 0) && sbAtomic[sbHead]);
+
+reg                  sWb = 1'b0;                // Writing back a snooped line
+reg                  sReq = 1'b0;               // Request not yet accepted
+reg [TAG_BITS-1:0]   sTag;
+reg [SET_BITS-1:0]   sSet;
+reg [WAY_BITS-1:0]   sWay;
+reg [WORD_BITS-1:0]  sWord;
+reg [WORD_BITS:0]    sCount;
+
+wire [SET_BITS-1:0] snoopSet = snoopAddr_i[OFF_BITS+SET_BITS-1:OFF_BITS];
+wire [TAG_BITS-1:0] snoopTag = snoopAddr_i[31:OFF_BITS+SET_BITS];
+
+reg                snoopHit;
+reg [WAY_BITS-1:0] snoopWay;
+integer sw;
+always @(*) begin
+        snoopHit = 1'b0;
+        snoopWay = 0;
+        for (sw = 0; sw < WAYS; sw = sw + 1) begin
+                if (lineValid[sw*SETS + snoopSet] && (tags[sw*SETS + snoopSet] == snoopTag)) begin
+                        snoopHit = 1'b1;
+                        snoopWay = sw[WAY_BITS-1:0];
+                end
+        end
+end
+wire snoopDirty = snoopHit && lineDirty[{snoopWay, snoopSet}];
+
+// Snoops are taken when the memory port is free: idle, or a refill still
+// waiting for the bus. A victim being written back finishes first.
+wire snoopTake = snoopValid_i && !sWb && !atomicHold && !reset_i &&
+        ((state == S_IDLE) || ((state == S_REFILL) && memReq));
+wire sWbDone = sWb && !sReq && memWReady_i && (sCount == LINE_WORDS - 1);
+assign snoopAck_o = (snoopTake && !snoopDirty) || sWbDone;
+
+wire fillBlock = snoopValid_i || sWb || atomicHold;
+
+/*--------------------LOOKUP----------------------*/
+wire [29:0] wordA = rAddr_i[31:2];
+wire [29:0] wordB = wordA + 1;
+wire [29:0] wordH = sbAddr[sbHead];
+wire [29:0] wordP = pfAddr_i[31:2];
+
+// Cache index {way, set, word} of a word address on a hit
+function [WAY_BITS+SET_BITS+WORD_BITS:0] lookup;
+        input [29:0] word;
+        integer w;
+        begin
+                lookup = 0;
+                for (w = 0; w < WAYS; w = w + 1) begin
+                        if (lineValid[w*SETS + word[OFF_BITS-2+SET_BITS-1:OFF_BITS-2]] &&
+                            (tags[w*SETS + word[OFF_BITS-2+SET_BITS-1:OFF_BITS-2]] ==
+                                word[29:OFF_BITS-2+SET_BITS])) begin
+                                lookup = {1'b1, w[WAY_BITS-1:0],
+                                        word[OFF_BITS-2+SET_BITS-1:0]};
+                        end
+                end
+                // Words of the line being refilled are usable as soon as they arrive
+                if ((state == S_REFILL) && (word[29:WORD_BITS] == mLine) &&
+                                mWordValid[word[WORD_BITS-1:0]]) begin
+                        lookup = {1'b1, mWay, word[OFF_BITS-2+SET_BITS-1:0]};
+                end
+        end
+endfunction
+
+wire [WAY_BITS+SET_BITS+WORD_BITS:0] lookupA = lookup(wordA);
+wire [WAY_BITS+SET_BITS+WORD_BITS:0] lookupB = lookup(wordB);
+wire [WAY_BITS+SET_BITS+WORD_BITS:0] lookupH = lookup(wordH);
+wire [WAY_BITS+SET_BITS+WORD_BITS:0] lookupP = lookup(wordP);
+
+wire hitA = lookupA[WAY_BITS+SET_BITS+WORD_BITS];
+wire hitB = lookupB[WAY_BITS+SET_BITS+WORD_BITS];
+wire hitH = lookupH[WAY_BITS+SET_BITS+WORD_BITS] && (sbCount != 0);
+wire hitP = lookupP[WAY_BITS+SET_BITS+WORD_BITS] ||
+            ((state != S_IDLE) && (wordP[29:WORD_BITS] == mLine));
+
+/*--------------------LOAD------------------------*/
+// Merge the bytes of buffered stores, oldest first
+reg [31:0] loadA;
+reg [31:0] loadB;
+reg        loadFwd;
+reg [SB_BITS-1:0] sbIdx;
+integer i;
+integer b;
+always @(*) begin
+        loadA = data[lookupA[WAY_BITS+SET_BITS+WORD_BITS-1:0]];
+        loadB = data[lookupB[WAY_BITS+SET_BITS+WORD_BITS-1:0]];
+        loadFwd = 1'b0;
+        for (i = 0; i < SB_DEPTH; i = i + 1) begin
+                sbIdx = sbHead + i;
+                if (i < sbCount) begin
+                        for (b = 0; b < 4; b = b + 1) begin
+                                if (sbMask[sbIdx][b] && (sbAddr[sbIdx] == wordA)) begin
+                                        loadA[b*8 +: 8] = sbData[sbIdx][b*8 +: 8];
+                                        loadFwd = 1'b1;
+                                end
+                                if (sbMask[sbIdx][b] && (sbAddr[sbIdx] == wordB) && rDouble_i) begin
+                                        loadB[b*8 +: 8] = sbData[sbIdx][b*8 +: 8];
+                                        loadFwd = 1'b1;
+                                end
+                        end
+                end
+        end
+end
+
+assign rData_o  = {loadB, loadA};
+assign rValid_o = hitA && (!rDouble_i || hitB);
+
+/*--------------------MEMORY PORT-----------------*/
+wire loadMiss  = rEnable_i && !rValid_o;
+wire storeMiss = (sbCount != 0) && !hitH;
+wire [29:0] missWord = loadMiss ? (hitA ? wordB : wordA) : wordH;
+wire missStart = (state == S_IDLE) && (loadMiss || storeMiss) && !fillBlock && !reset_i;
+
+// Prefetch only when there is no demand miss, drop it if the line is present
+assign pfReady_o = (state == S_IDLE) && !fillBlock && !loadMiss && !storeMiss;
+wire   pfStart   = pfReady_o && pfValid_i && !hitP && !reset_i;
+wire   fillStart = missStart || pfStart;
+wire [29:0] fillWord = missStart ? missWord : wordP;
+wire [SET_BITS-1:0] fillSet = fillWord[OFF_BITS-2+SET_BITS-1:OFF_BITS-2];
+assign pfIssue_o = pfStart;
+
+// A snooped line being written back takes the port from a waiting refill
+assign memReqValid_o = sWb ? sReq : memReq;
+assign memReqWrite_o = sWb || (state == S_WBACK);
+assign memReqAddr_o  = sWb ? {sTag, sSet, {OFF_BITS{1'b0}}} :
+                       (state == S_WBACK) ? {mWbTag, mSet, {OFF_BITS{1'b0}}} :
+                                            {mLine, mWord, 2'b00};
+assign memReqLen_o   = LINE_WORDS;
+assign memWValid_o   = sWb ? !sReq : (state == S_WBACK) && !memReq;
+assign memWData_o    = sWb ? data[{sWay, sSet, sWord}] : data[{mWay, mSet, mWord}];
+
+// Drain the head of the store buffer when it hits and no refill word is being
+// written. Wait while a miss starts or a snoop is taken since either may
+// remove the line of the head.
+wire refillWrite = (state == S_REFILL) && !memReq && memRespValid_i;
+wire sbDrain = hitH && !refillWrite && !fillStart && !snoopTake;
+
+/*--------------------RESERVATION-----------------*/
+wire [31-OFF_BITS:0] watchLine = watchAddr_i[31:OFF_BITS];
+assign watchLost_o =
+        (fillStart && lineValid[{victim, fillSet}] &&
+                ({tags[{victim, fillSet}], fillSet} == watchLine)) ||
+        (snoopTake && snoopHit && (snoopAddr_i[31:OFF_BITS] == watchLine));
+
+/*--------------------PREFETCH FEEDBACK-----------*/
+// First demand access to a prefetched line, or to a prefetch being refilled
+wire [WAY_BITS+SET_BITS-1:0] lineA = lookupA[WAY_BITS+SET_BITS+WORD_BITS-1:WORD_BITS];
+wire [WAY_BITS+SET_BITS-1:0] lineB = lookupB[WAY_BITS+SET_BITS+WORD_BITS-1:WORD_BITS];
+wire [WAY_BITS+SET_BITS-1:0] lineH = lookupH[WAY_BITS+SET_BITS+WORD_BITS-1:WORD_BITS];
+wire pfUseA = rEnable_i && hitA && linePf[lineA];
+wire pfUseB = rEnable_i && rDouble_i && hitB && linePf[lineB] && (lineB != lineA);
+wire pfUseH = sbDrain && linePf[lineH];
+wire pfUseM = (state == S_REFILL) && mPrefetch &&
+        ((rEnable_i && ((wordA[29:WORD_BITS] == mLine) ||
+                        (rDouble_i && (wordB[29:WORD_BITS] == mLine)))) ||
+         ((sbCount != 0) && (wordH[29:WORD_BITS] == mLine)));
+assign pfUseful_o = pfUseA + pfUseB + pfUseH + pfUseM;
+assign pfLate_o   = pfUseM && (loadMiss || storeMiss);
+
+integer d;
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                state   <= S_IDLE;
+                memReq  <= 1'b0;
+                sbHead  <= 0;
+                sbCount <= 0;
+                sWb     <= 1'b0;
+                sReq    <= 1'b0;
+        end else begin
+                /******** Snoop ********/
+                if (snoopTake) begin
+                        if (snoopHit) begin
+                                lineValid[{snoopWay, snoopSet}] <= 1'b0;
+                                lineDirty[{snoopWay, snoopSet}] <= 1'b0;
+                                linePf[{snoopWay, snoopSet}]    <= 1'b0;
+                                snoopCount <= snoopCount + 1;
+                        end
+                        if (snoopDirty) begin
+                                sWb    <= 1'b1;
+                                sReq   <= 1'b1;
+                                sTag   <= snoopTag;
+                                sSet   <= snoopSet;
+                                sWay   <= snoopWay;
+                                sWord  <= 0;
+                                sCount <= 0;
+                                snoopWbCount <= snoopWbCount + 1;
+                        end
+                end
+                if (sWb) begin
+                        if (memReqReady_i)
+                                sReq <= 1'b0;
+                        if (!sReq && memWReady_i) begin
+                                sWord  <= sWord + 1;
+                                sCount <= sCount + 1;
+                                if (sCount == LINE_WORDS - 1)
+                                        sWb <= 1'b0;
+                        end
+                end
+
+                /******** Miss Handling ********/
+                if (!sWb) case (state)
+                S_IDLE: if (fillStart) begin
+                        mLine      <= fillWord[29:WORD_BITS];
+                        mWay       <= victim;
+                        mCrit      <= fillWord[WORD_BITS-1:0];
+                        mWbTag     <= tags[{victim, fillSet}];
+                        mCount     <= 0;
+                        mWordValid <= 0;
+                        mPrefetch  <= !missStart;
+                        memReq     <= 1'b1;
+                        victim     <= (WAYS > 1) ? victim + 1 : 0;
+
+                        // Write back the victim first if it is dirty
+                        if (lineValid[{victim, fillSet}] && lineDirty[{victim, fillSet}]) begin
+                                state <= S_WBACK;
+                                mWord <= 0;
+                                writebackCount <= writebackCount + 1;
+                        end else begin
+                                state <= S_REFILL;
+                                mWord <= fillWord[WORD_BITS-1:0];
+                        end
+
+                        // The way is invalid until the new line is written
+                        lineValid[{victim, fillSet}] <= 1'b0;
+                        lineDirty[{victim, fillSet}] <= 1'b0;
+                        linePf[{victim, fillSet}]    <= 1'b0;
+                        tags[{victim, fillSet}] <= fillWord[29:OFF_BITS-2+SET_BITS];
+
+                        if (loadMiss)
+                                loadMissCount <= loadMissCount + 1;
+                        else if (storeMiss)
+                                storeMissCount <= storeMissCount + 1;
+                end
+                S_WBACK: begin
+                        if (memReqReady_i)
+                                memReq <= 1'b0;
+                        if (!memReq && memWReady_i) begin
+                                mWord  <= mWord + 1;
+                                mCount <= mCount + 1;
+                                if (mCount == LINE_WORDS - 1) begin
+                                        state  <= S_REFILL;
+                                        memReq <= 1'b1;
+                                        mWord  <= mCrit;
+                                        mCount <= 0;
+                                end
+                        end
+                end
+                S_REFILL: begin
+                        if (memReqReady_i)
+                                memReq <= 1'b0;
+                        if (refillWrite) begin
+                                data[{mWay, mSet, mWord}] <= memRespData_i;
+                                mWordValid[mWord] <= 1'b1;
+                                mWord  <= mWord + 1;
+                                mCount <= mCount + 1;
+                                if (mCount == LINE_WORDS - 1) begin
+                                        state <= S_IDLE;
+                                        lineValid[{mWay, mSet}] <= 1'b1;
+                                        linePf[{mWay, mSet}] <= mPrefetch && !pfUseM;
+                                end
+                        end
+                        if (pfUseM)
+                                mPrefetch <= 1'b0;
+                end
+                default: state <= S_IDLE;
+                endcase
+
+                /******** Prefetch Feedback ********/
+                if (pfUseA)
+                        linePf[lineA] <= 1'b0;
+                if (pfUseB)
+                        linePf[lineB] <= 1'b0;
+                if (pfUseH)
+                        linePf[lineH] <= 1'b0;
+
+                /******** Store Buffer ********/
+                if (sbDrain) begin
+                        for (d = 0; d < 4; d = d + 1) begin
+                                if (sbMask[sbHead][d])
+                                        data[lookupH[WAY_BITS+SET_BITS+WORD_BITS-1:0]][d*8 +: 8] <=
+                                                sbData[sbHead][d*8 +: 8];
+                        end
+                        lineDirty[lookupH[WAY_BITS+SET_BITS+WORD_BITS-1:WORD_BITS]] <= 1'b1;
+                        sbHead <= sbHead + 1;
+                end
+
+                if (sbPushLo) begin
+                        sbAddr[sbTail] <= wAddr_i[31:2];
+                        sbData[sbTail] <= wData_i[31:0];
+                        sbMask[sbTail] <= wMask_i[3:0];
+                        sbAtomic[sbTail] <= wAtomic_i;
+                end
+                if (sbPushHi) begin
+                        sbAddr[sbTail + sbPushLo] <= wAddr_i[31:2] + 1;
+                        sbData[sbTail + sbPushLo] <= wData_i[63:32];
+                        sbMask[sbTail + sbPushLo] <= 4'b1111;
+                        sbAtomic[sbTail + sbPushLo] <= 1'b0;
+                end
+                sbCount <= sbCount + sbPushN - sbDrain;
+        end
+
+        if (rEnable_i && rValid_o) begin
+                loadHitCount <= loadHitCount + 1;
+                if (loadFwd)
+                        sbForwardCount <= sbForwardCount + 1;
+        end
+        if (loadMiss) begin
+                missCycles <= missCycles + 1;
+        end
+        if (sbAlmostFull_o) begin
+                sbFullCycles <= sbFullCycles + 1;
+        end
+end
+
+endmodule
+/* verilator lint_on WIDTH */
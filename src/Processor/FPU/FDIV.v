@@ -56,8 +56,11 @@ reg signed [NEXP+1:0] expIn;
 reg  [5:0] counter;
 // Only one cycle is needed to handle special cases
 localparam SPECIAL_CYCLES = 1;
-// Enough cycles to compute full significand with extra bits for rounding and normalizing
-localparam DIVIDE_CYCLES = NSIG + 4;
+// The quotient has NSIG + 3 bits for rounding and normalizing. Radix 4: two
+// bits per cycle, the first cycle also computes the odd bit if there is one.
+localparam FIRST_BITS = 1 + ((NSIG + 2) % 2);
+localparam DIVIDE_CYCLES = (NSIG + 3 - FIRST_BITS) / 2 + 2;
+integer i;
 
 // Status Flags
 reg special;    // Special Cases (NaN, inf, zero)
@@ -127,22 +130,26 @@ always @(posedge clk_i) begin
                                 bSig = {2'b00, rs2Sig_i};
                                 expNorm <= 0;
 
-                                // Compute first bit of quotient significand
-                                rSig = aSig - bSig;
-                                qSig = {qSig[NSIG+1:0], ~rSig[NSIG+2]};
-                                aSig = {(rSig[NSIG+2] ? aSig[NSIG+1:0] : rSig[NSIG+1:0]), 1'b0};
+                                // Compute first bits of quotient significand
+                                for (i = 0; i < FIRST_BITS; i = i + 1) begin
+                                        rSig = aSig - bSig;
+                                        qSig = {qSig[NSIG+1:0], ~rSig[NSIG+2]};
+                                        aSig = {(rSig[NSIG+2] ? aSig[NSIG+1:0] : rSig[NSIG+1:0]), 1'b0};
+                                end
 
                                 // DEBUG: Show current state of computation
                                 divOut = {{FLEN-(NSIG+3){1'b0}}, qSig};
                         end
                 endcase
                 /* verilator lint_on CASEOVERLAP */
-        end else if (counter > 2) begin // Continue computing significand
+        end else if (counter > 2) begin // Continue computing significand, 2 bits per cycle
                 counter <= counter - 1;
 
-                rSig = aSig - bSig;
-                qSig = {qSig[NSIG+1:0], ~rSig[NSIG+2]};
-                aSig = {(rSig[NSIG+2] ? aSig[NSIG+1:0] : rSig[NSIG+1:0]), 1'b0};
+                for (i = 0; i < 2; i = i + 1) begin
+                        rSig = aSig - bSig;
+                        qSig = {qSig[NSIG+1:0], ~rSig[NSIG+2]};
+                        aSig = {(rSig[NSIG+2] ? aSig[NSIG+1:0] : rSig[NSIG+1:0]), 1'b0};
+                end
 
                 // DEBUG: Show current state of computation
                 divOut = {{FLEN-(NSIG+3){1'b0}}, qSig};
@@ -14,26 +14,88 @@ module FPU (
         input  wire [31:0] instr_i,
         input  wire [63:0] rs1_i,
         input  wire [63:0] rs2_i,
-        input  wire [63:0] rs3_i,
         input  wire [2:0]  rm_i,
         output wire [4:0]  fflags_o,
 
         output wire        busy_o,
-        output wire [63:0] fpuOut_o
+        output wire [63:0] fpuOut_o,
+
+        // Long latency ops (FDIV, FSQRT)
+        input  wire        stall_i,
+        input  wire [5:0]  rdId_i,
+        input  wire        longAck_i,
+        output wire        longIssue_o,
+        output wire        longReady_o,
+        output wire [5:0]  longRdId_o,
+        output wire [31:0] longInstr_o,
+        output wire [63:0] longOut_o
 );
 
 reg [31:0] out_s;
 reg [63:0] out_d;
 assign fpuOut_o = isRV32D ? out_d : {{32{1'b1}}, out_s};
-assign busy_o = fpuEnable_i & ((isFDIV_S & ~fdivReady)   | (isFSQRT_S & ~fsqrtReady) | 
-                               (isFDIV_D & ~fdivReady_d));
+// Only stall if the unit for a long latency op is still occupied
+assign busy_o = fpuEnable_i & ((isFDIV_S & fdivActive) | (isFSQRT_S & fsqrtActive) |
+                               (isFDIV_D & fdivActive_d) | (isFSQRT_D & fsqrtActive_d));
+
+/*
+ * Long latency ops run in the background. Operands are latched on issue and
+ * the result is held until the execute unit acknowledges it. Each unit can
+ * hold one op, so a second op to the same unit stalls until it is free.
+ */
+reg        fdivActive = 1'b0;
+reg        fdivDone = 1'b0;
+reg [5:0]  fdivRdId;
+reg [31:0] fdivInstr;
+reg [31:0] fdivRs1;
+reg [31:0] fdivRs2;
+reg signed [9:0]  fdivRs1Exp;
+reg signed [9:0]  fdivRs2Exp;
+reg        [23:0] fdivRs1Sig;
+reg        [23:0] fdivRs2Sig;
+reg        [5:0]  fdivRs1Class;
+reg        [5:0]  fdivRs2Class;
+reg        [2:0]  fdivRm;
+
+reg        fsqrtActive = 1'b0;
+reg        fsqrtDone = 1'b0;
+reg [5:0]  fsqrtRdId;
+reg [31:0] fsqrtInstr;
+reg [31:0] fsqrtRs1;
+reg signed [9:0]  fsqrtRs1Exp;
+reg        [23:0] fsqrtRs1Sig;
+reg        [5:0]  fsqrtRs1Class;
+reg        [2:0]  fsqrtRm;
+
+reg        fdivActive_d = 1'b0;
+reg        fdivDone_d = 1'b0;
+reg [5:0]  fdivRdId_d;
+reg [31:0] fdivInstr_d;
+reg [63:0] fdivRs1_d;
+reg [63:0] fdivRs2_d;
+reg signed [12:0] fdivRs1Exp_d;
+reg signed [12:0] fdivRs2Exp_d;
+reg        [52:0] fdivRs1Sig_d;
+reg        [52:0] fdivRs2Sig_d;
+reg        [5:0]  fdivRs1Class_d;
+reg        [5:0]  fdivRs2Class_d;
+reg        [2:0]  fdivRm_d;
+
+reg        fsqrtActive_d = 1'b0;
+reg        fsqrtDone_d = 1'b0;
+reg [5:0]  fsqrtRdId_d;
+reg [31:0] fsqrtInstr_d;
+reg [63:0] fsqrtRs1_d;
+reg signed [12:0] fsqrtRs1Exp_d;
+reg        [52:0] fsqrtRs1Sig_d;
+reg        [5:0]  fsqrtRs1Class_d;
+reg        [2:0]  fsqrtRm_d;
 
 reg [4:0] fflags = 0;
 assign fflags_o = fflags;
 
 wire [31:0] rs1_s = rs1_i[31:0];
 wire [31:0] rs2_s = rs2_i[31:0];
-wire [31:0] rs3_s = rs3_i[31:0];
 
 // Decode floating point numbers
 wire        [9:0]  rs1FullClass;
@@ -47,83 +109,6 @@ wire signed [9:0]  rs2Exp;
 wire        [23:0] rs2Sig;
 FClass class2(.reg_i(rs2_s), .regExp_o(rs2Exp), .regSig_o(rs2Sig),
         .class_o(rs2Class), .fullClass_o());
-wire        [5:0]  rs3Class;
-wire signed [9:0]  rs3Exp;
-wire        [23:0] rs3Sig;
-FClass class3(.reg_i(rs3_s), .regExp_o(rs3Exp), .regSig_o(rs3Sig),
-        .class_o(rs3Class), .fullClass_o());
-
-// Multiplication
-wire [31:0] fmulOut;
-// Keep unrounded output for FMA instructions
-wire        [47:0] fmulSig;
-wire signed [10:0] fmulExp;
-wire        [5:0]  fmulClass;
-FMUL fmul(
-        .rs1_i(rs1_s),
-        .rs1Exp_i(rs1Exp),
-        .rs1Sig_i(rs1Sig),
-        .rs1Class_i(rs1Class),
-        .rs2_i(rs2_s),
-        .rs2Exp_i(rs2Exp),
-        .rs2Sig_i(rs2Sig),
-        .rs2Class_i(rs2Class),
-        .rm_i(rm_i),
-        .fmulOut_o(fmulOut),
-        .exp_o(fmulExp),
-        .sig_o(fmulSig),
-        .class_o(fmulClass)
-);
-
-// Addition / Subtraction
-// Need to Determine what inputs to use and negate the second one if subtracting
-// rs1 + rs2 for add/sub and mulOut + rs3 for madd/msub
-reg        [31:0] addRs1;
-reg        [47:0] addRs1Sig;
-reg signed [10:0] addRs1Exp;
-reg        [5:0]  addRs1Class;
-reg        [31:0] addRs2;
-reg        [47:0] addRs2Sig;
-reg signed [10:0] addRs2Exp;
-reg        [5:0]  addRs2Class;
-
-always @(*) begin
-        if (isFMA) begin
-                addRs1      = (isFNMADD || isFNMSUB) ? {~fmulOut[31], fmulOut[30:0]} : fmulOut;
-                addRs1Sig   = fmulSig;
-                addRs1Exp   = fmulExp;
-                addRs1Class = fmulClass;
-
-                addRs2      = (isFNMADD || isFMSUB) ? {~rs3_s[31], rs3_s[30:0]} : rs3_s;
-                addRs2Sig   = {rs3Sig, 24'b0};
-                addRs2Exp   = {rs3Exp[9], rs3Exp};
-                addRs2Class = rs3Class;
-        end else begin
-                addRs1      = rs1_s;
-                addRs1Sig   = {rs1Sig, 24'b0};
-                addRs1Exp   = {rs1Exp[9], rs1Exp};
-                addRs1Class = rs1Class;
-
-                addRs2      = (isFSUB_S) ? {~rs2_s[31], rs2_s[30:0]} : rs2_s;
-                addRs2Sig   = {rs2Sig, 24'b0};
-                addRs2Exp   = {rs2Exp[9], rs2Exp};
-                addRs2Class = rs2Class;
-        end
-end
-
-wire [31:0] faddOut;
-FADDd fadd(
-        .rs1_i(addRs1),
-        .rs1Exp_i(addRs1Exp),
-        .rs1Sig_i(addRs1Sig),
-        .rs1Class_i(addRs1Class),
-        .rs2_i(addRs2),
-        .rs2Exp_i(addRs2Exp),
-        .rs2Sig_i(addRs2Sig),
-        .rs2Class_i(addRs2Class),
-        .rm_i(rm_i),
-        .faddOut_o(faddOut)
-);
 
 // Division
 wire [31:0] fdivOut;
@@ -131,16 +116,16 @@ wire        fdivReady;
 FDIV fdiv(
         .clk_i(clk_i),
         .reset_i(reset_i),
-        .divEnable_i(fpuEnable_i & isFDIV_S),
-        .rs1_i(rs1_s),
-        .rs1Exp_i(rs1Exp),
-        .rs1Sig_i(rs1Sig),
-        .rs1Class_i(rs1Class),
-        .rs2_i(rs2_s),
-        .rs2Exp_i(rs2Exp),
-        .rs2Sig_i(rs2Sig),
-        .rs2Class_i(rs2Class),
-        .rm_i(rm_i),
+        .divEnable_i(fdivActive & ~fdivDone & ~fdivReady),
+        .rs1_i(fdivRs1),
+        .rs1Exp_i(fdivRs1Exp),
+        .rs1Sig_i(fdivRs1Sig),
+        .rs1Class_i(fdivRs1Class),
+        .rs2_i(fdivRs2),
+        .rs2Exp_i(fdivRs2Exp),
+        .rs2Sig_i(fdivRs2Sig),
+        .rs2Class_i(fdivRs2Class),
+        .rm_i(fdivRm),
         .ready_o(fdivReady),
         .fdivOut_o(fdivOut)
 );
@@ -151,12 +136,12 @@ wire        fsqrtReady;
 FSQRT fsqrt(
         .clk_i(clk_i),
         .reset_i(reset_i),
-        .sqrtEnable_i(fpuEnable_i & isFSQRT_S),
-        .rs1_i(rs1_s),
-        .rs1Exp_i(rs1Exp),
-        .rs1Sig_i(rs1Sig),
-        .rs1Class_i(rs1Class),
-        .rm_i(rm_i),
+        .sqrtEnable_i(fsqrtActive & ~fsqrtDone & ~fsqrtReady),
+        .rs1_i(fsqrtRs1),
+        .rs1Exp_i(fsqrtRs1Exp),
+        .rs1Sig_i(fsqrtRs1Sig),
+        .rs1Class_i(fsqrtRs1Class),
+        .rm_i(fsqrtRm),
         .ready_o(fsqrtReady),
         .fsqrtOut_o(fsqrtOut)
 );
@@ -203,88 +188,6 @@ wire        [52:0] rs2Sig_d;
 FClass #(.FLen(64), .SigLen(52), .ExpLen(11)
 )class2_d(.reg_i(rs2_i), .regExp_o(rs2Exp_d), .regSig_o(rs2Sig_d),
         .class_o(rs2Class_d), .fullClass_o());
-wire        [5:0]  rs3Class_d;
-wire signed [12:0]  rs3Exp_d;
-wire        [52:0] rs3Sig_d;
-FClass #(.FLen(64), .SigLen(52), .ExpLen(11)
-)class3_d(.reg_i(rs3_i), .regExp_o(rs3Exp_d), .regSig_o(rs3Sig_d),
-        .class_o(rs3Class_d), .fullClass_o());
-
-// Multiplication
-wire [63:0] fmulOut_d;
-// Keep unrounded output for FMA instructions
-wire        [105:0] fmulSig_d;
-wire signed [13:0] fmulExp_d;
-wire        [5:0]  fmulClass_d;
-FMUL #(
-        .FLEN(64)
-)fmul_d(
-        .rs1_i(rs1_i),
-        .rs1Exp_i(rs1Exp_d),
-        .rs1Sig_i(rs1Sig_d),
-        .rs1Class_i(rs1Class_d),
-        .rs2_i(rs2_i),
-        .rs2Exp_i(rs2Exp_d),
-        .rs2Sig_i(rs2Sig_d),
-        .rs2Class_i(rs2Class_d),
-        .rm_i(rm_i),
-        .fmulOut_o(fmulOut_d),
-        .exp_o(fmulExp_d),
-        .sig_o(fmulSig_d),
-        .class_o(fmulClass_d)
-);
-
-// Addition / Subtraction
-// Need to Determine what inputs to use and negate the second one if subtracting
-// rs1 + rs2 for add/sub and mulOut + rs3 for madd/msub
-reg        [63:0]  addRs1_d;
-reg        [105:0] addRs1Sig_d;
-reg signed [13:0]  addRs1Exp_d;
-reg        [5:0]   addRs1Class_d;
-reg        [63:0]  addRs2_d;
-reg        [105:0] addRs2Sig_d;
-reg signed [13:0]  addRs2Exp_d;
-reg        [5:0]   addRs2Class_d;
-
-always @(*) begin
-        if (isFMA) begin
-                addRs1_d      = (isFNMADD || isFNMSUB) ? {~fmulOut_d[63], fmulOut_d[62:0]} : fmulOut_d;
-                addRs1Sig_d   = fmulSig_d;
-                addRs1Exp_d   = fmulExp_d;
-                addRs1Class_d = fmulClass_d;
-
-                addRs2_d      = (isFNMADD || isFMSUB) ? {~rs3_i[63], rs3_i[62:0]} : rs3_i;
-                addRs2Sig_d   = {rs3Sig_d, 53'b0};
-                addRs2Exp_d   = {rs3Exp_d[9], rs3Exp_d};
-                addRs2Class_d = rs3Class_d;
-        end else begin
-                addRs1_d      = rs1_i;
-                addRs1Sig_d   = {rs1Sig_d, 53'b0};
-                addRs1Exp_d   = {rs1Exp_d[12], rs1Exp_d};
-                addRs1Class_d = rs1Class_d;
-
-                addRs2_d      = (isFSUB_D) ? {~rs2_i[63], rs2_i[62:0]} : rs2_i;
-                addRs2Sig_d   = {rs2Sig_d, 53'b0};
-                addRs2Exp_d   = {rs2Exp_d[12], rs2Exp_d};
-                addRs2Class_d = rs2Class_d;
-        end
-end
-
-wire [63:0] faddOut_d;
-FADDd #(
-        .FLEN(64)
-)fadd_d(
-        .rs1_i(addRs1_d),
-        .rs1Exp_i(addRs1Exp_d),
-        .rs1Sig_i(addRs1Sig_d),
-        .rs1Class_i(addRs1Class_d),
-        .rs2_i(addRs2_d),
-        .rs2Exp_i(addRs2Exp_d),
-        .rs2Sig_i(addRs2Sig_d),
-        .rs2Class_i(addRs2Class_d),
-        .rm_i(rm_i),
-        .faddOut_o(faddOut_d)
-);
 
 // Division
 wire [63:0] fdivOut_d;
@@ -294,20 +197,38 @@ FDIV #(
 )fdiv_d(
         .clk_i(clk_i),
         .reset_i(reset_i),
-        .divEnable_i(fpuEnable_i & isFDIV_D),
-        .rs1_i(rs1_i),
-        .rs1Exp_i(rs1Exp_d),
-        .rs1Sig_i(rs1Sig_d),
-        .rs1Class_i(rs1Class_d),
-        .rs2_i(rs2_i),
-        .rs2Exp_i(rs2Exp_d),
-        .rs2Sig_i(rs2Sig_d),
-        .rs2Class_i(rs2Class_d),
-        .rm_i(rm_i),
+        .divEnable_i(fdivActive_d & ~fdivDone_d & ~fdivReady_d),
+        .rs1_i(fdivRs1_d),
+        .rs1Exp_i(fdivRs1Exp_d),
+        .rs1Sig_i(fdivRs1Sig_d),
+        .rs1Class_i(fdivRs1Class_d),
+        .rs2_i(fdivRs2_d),
+        .rs2Exp_i(fdivRs2Exp_d),
+        .rs2Sig_i(fdivRs2Sig_d),
+        .rs2Class_i(fdivRs2Class_d),
+        .rm_i(fdivRm_d),
         .ready_o(fdivReady_d),
         .fdivOut_o(fdivOut_d)
 );
 
+// Square Root
+wire [63:0] fsqrtOut_d;
+wire        fsqrtReady_d;
+FSQRT #(
+        .FLEN(64)
+)fsqrt_d(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .sqrtEnable_i(fsqrtActive_d & ~fsqrtDone_d & ~fsqrtReady_d),
+        .rs1_i(fsqrtRs1_d),
+        .rs1Exp_i(fsqrtRs1Exp_d),
+        .rs1Sig_i(fsqrtRs1Sig_d),
+        .rs1Class_i(fsqrtRs1Class_d),
+        .rm_i(fsqrtRm_d),
+        .ready_o(fsqrtReady_d),
+        .fsqrtOut_o(fsqrtOut_d)
+);
+
 // Comparisons
 wire [2:0] fcmpOut_d; // {FLT, FLE, FEQ}
 FCMP #(
@@ -358,6 +279,119 @@ FCVTDS fcvt_ds(
         .fullClass_o()
 );
 
+/************************ Long Latency Ops ************************/
+wire fdivIssue   = fpuEnable_i & isFDIV_S  & ~fdivActive   & ~stall_i;
+wire fsqrtIssue  = fpuEnable_i & isFSQRT_S & ~fsqrtActive  & ~stall_i;
+wire fdivIssue_d = fpuEnable_i & isFDIV_D  & ~fdivActive_d & ~stall_i;
+wire fsqrtIssue_d = fpuEnable_i & isFSQRT_D & ~fsqrtActive_d & ~stall_i;
+assign longIssue_o = fdivIssue | fsqrtIssue | fdivIssue_d | fsqrtIssue_d;
+
+// Write back priority: FDIV.S, FDIV.D, FSQRT.S, FSQRT.D
+wire fdivSel    = fdivDone;
+wire fdivSel_d  = ~fdivDone & fdivDone_d;
+wire fsqrtSel   = ~fdivDone & ~fdivDone_d & fsqrtDone;
+wire fsqrtSel_d = ~fdivDone & ~fdivDone_d & ~fsqrtDone & fsqrtDone_d;
+
+assign longReady_o = fdivDone | fdivDone_d | fsqrtDone | fsqrtDone_d;
+assign longRdId_o  = fdivSel ? fdivRdId  : fdivSel_d ? fdivRdId_d  :
+                     fsqrtSel ? fsqrtRdId : fsqrtRdId_d;
+assign longInstr_o = fdivSel ? fdivInstr : fdivSel_d ? fdivInstr_d :
+                     fsqrtSel ? fsqrtInstr : fsqrtInstr_d;
+assign longOut_o   =
+        fdivSel   ? {32'hFFFFFFFF, fdivOut}  :
+        fdivSel_d ? fdivOut_d                :
+        fsqrtSel  ? {32'hFFFFFFFF, fsqrtOut} :
+                    fsqrtOut_d               ;
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                fdivActive   <= 1'b0;
+                fsqrtActive  <= 1'b0;
+                fdivActive_d <= 1'b0;
+                fsqrtActive_d <= 1'b0;
+        end else begin
+                /******** FDIV.S ********/
+                if (fdivIssue) begin
+                        fdivActive   <= 1'b1;
+                        fdivDone     <= 1'b0;
+                        fdivRdId     <= rdId_i;
+                        fdivInstr    <= instr_i;
+                        fdivRs1      <= rs1_s;
+                        fdivRs1Exp   <= rs1Exp;
+                        fdivRs1Sig   <= rs1Sig;
+                        fdivRs1Class <= rs1Class;
+                        fdivRs2      <= rs2_s;
+                        fdivRs2Exp   <= rs2Exp;
+                        fdivRs2Sig   <= rs2Sig;
+                        fdivRs2Class <= rs2Class;
+                        fdivRm       <= rm_i;
+                end else if (longAck_i & fdivSel) begin
+                        fdivActive <= 1'b0;
+                        fdivDone   <= 1'b0;
+                end else if (fdivReady) begin
+                        fdivDone   <= 1'b1;
+                end
+
+                /******** FSQRT.S ********/
+                if (fsqrtIssue) begin
+                        fsqrtActive   <= 1'b1;
+                        fsqrtDone     <= 1'b0;
+                        fsqrtRdId     <= rdId_i;
+                        fsqrtInstr    <= instr_i;
+                        fsqrtRs1      <= rs1_s;
+                        fsqrtRs1Exp   <= rs1Exp;
+                        fsqrtRs1Sig   <= rs1Sig;
+                        fsqrtRs1Class <= rs1Class;
+                        fsqrtRm       <= rm_i;
+                end else if (longAck_i & fsqrtSel) begin
+                        fsqrtActive <= 1'b0;
+                        fsqrtDone   <= 1'b0;
+                end else if (fsqrtReady) begin
+                        fsqrtDone   <= 1'b1;
+                end
+
+                /******** FDIV.D ********/
+                if (fdivIssue_d) begin
+                        fdivActive_d   <= 1'b1;
+                        fdivDone_d     <= 1'b0;
+                        fdivRdId_d     <= rdId_i;
+                        fdivInstr_d    <= instr_i;
+                        fdivRs1_d      <= rs1_i;
+                        fdivRs1Exp_d   <= rs1Exp_d;
+                        fdivRs1Sig_d   <= rs1Sig_d;
+                        fdivRs1Class_d <= rs1Class_d;
+                        fdivRs2_d      <= rs2_i;
+                        fdivRs2Exp_d   <= rs2Exp_d;
+                        fdivRs2Sig_d   <= rs2Sig_d;
+                        fdivRs2Class_d <= rs2Class_d;
+                        fdivRm_d       <= rm_i;
+                end else if (longAck_i & fdivSel_d) begin
+                        fdivActive_d <= 1'b0;
+                        fdivDone_d   <= 1'b0;
+                end else if (fdivReady_d) begin
+                        fdivDone_d   <= 1'b1;
+                end
+
+                /******** FSQRT.D ********/
+                if (fsqrtIssue_d) begin
+                        fsqrtActive_d   <= 1'b1;
+                        fsqrtDone_d     <= 1'b0;
+                        fsqrtRdId_d     <= rdId_i;
+                        fsqrtInstr_d    <= instr_i;
+                        fsqrtRs1_d      <= rs1_i;
+                        fsqrtRs1Exp_d   <= rs1Exp_d;
+                        fsqrtRs1Sig_d   <= rs1Sig_d;
+                        fsqrtRs1Class_d <= rs1Class_d;
+                        fsqrtRm_d       <= rm_i;
+                end else if (longAck_i & fsqrtSel_d) begin
+                        fsqrtActive_d <= 1'b0;
+                        fsqrtDone_d   <= 1'b0;
+                end else if (fsqrtReady_d) begin
+                        fsqrtDone_d   <= 1'b1;
+                end
+        end
+end
+
 /************************ Instruction Decoding ************************/
 always @(*) begin
         case (1'b1)
@@ -377,14 +411,6 @@ always @(*) begin
                 isFMAX_S | isFMIN_S      : out_s = (fcmpOut[2] ^ isFMAX) ? rs1_s : rs2_s;
                 isFCLASS_S               : out_s = {22'b0, rs1FullClass};
 
-                // Computations
-                isFMUL_S                 : out_s = fmulOut;
-                isFADD_S   | isFSUB_S    : out_s = faddOut;
-                isFMADD_S  | isFMSUB_S   : out_s = faddOut;
-                isFNMADD_S | isFNMSUB_S  : out_s = faddOut;
-                isFDIV_S                 : out_s = fdivOut;
-                isFSQRT_S                : out_s = fsqrtOut;
-
                 /******** Double Precision ********/
                 // Move and convert
                 isFSGNJ_D                : out_d = {           rs2_i[63], rs1_i[62:0]};
@@ -402,13 +428,7 @@ always @(*) begin
                 isFMAX_D | isFMIN_D      : out_d = (fcmpOut_d[2] ^ isFMAX_D) ? rs1_i : rs2_i;
                 isFCLASS_D               : out_d = {54'b0, rs1FullClass_d};
 
-                // Computations
-                isFMUL_D                 : out_d = fmulOut_d;
-                isFADD_D   | isFSUB_D    : out_d = faddOut_d;
-                isFMADD_D  | isFMSUB_D   : out_d = faddOut_d;
-                isFNMADD_D | isFNMSUB_D  : out_d = faddOut_d;
-                isFDIV_D                 : out_d = fdivOut_d;
-                // isFSQRT_D                : out_d = fsqrtOut_d;
+                // FADD, FSUB, FMUL and FMA are in FPUPipe, FDIV and FSQRT are long ops
                 default                  : out_d = 0;
         endcase
 end
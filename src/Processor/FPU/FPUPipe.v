@@ -0,0 +1,342 @@
+/*************************************************
+ *File----------FPUPipe.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Sunday Oct 18, 2026 20:04:37 UTC
+ ************************************************/
+
+module FPUPipe (
+        input  wire        clk_i,
+        input  wire        reset_i,
+
+        // Issue from the execute stage
+        input  wire        issue_i,
+        input  wire [31:0] instr_i,
+        input  wire [5:0]  rdId_i,
+        input  wire [63:0] rs1_i,
+        input  wire [63:0] rs2_i,
+        input  wire [63:0] rs3_i,
+        input  wire [2:0]  rm_i,
+
+        // Op in the last stage. Its result is in the output register next cycle
+        output wire        finishing_o,
+        output wire [5:0]  finishingRdId_o,
+
+        // Result register. Forwarded to execute and written to the register file
+        output reg         resultValid_o,
+        output reg  [5:0]  resultRdId_o,
+        output reg  [63:0] result_o
+);
+
+/*
+ * Pipelined FADD, FSUB, FMUL and FMA (single and double precision)
+ * X1: Classify the operands, multiply and select the adder inputs
+ * X2: Add, normalize and round
+ * A new op can be issued every cycle. The result is available for forwarding
+ * 3 cycles after issue.
+ */
+
+/*---------------------ISSUE----------------------*/
+wire isFMA   = !instr_i[4];
+
+reg         X1_valid = 1'b0;
+reg  [5:0]  X1_rdId;
+reg         X1_isD;
+reg         X1_isFMA;
+reg         X1_isFMUL;
+reg         X1_isFSUB;
+reg         X1_negProd;         // FNMADD, FNMSUB
+reg         X1_negAddend;       // FNMADD, FMSUB
+reg  [2:0]  X1_rm;
+reg  [63:0] X1_rs1;
+reg  [63:0] X1_rs2;
+reg  [63:0] X1_rs3;
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                X1_valid <= 1'b0;
+        end else begin
+                X1_valid <= issue_i;
+        end
+
+        X1_rdId      <= rdId_i;
+        X1_isD       <= instr_i[25];
+        X1_isFMA     <= isFMA;
+        X1_isFMUL    <= !isFMA && (instr_i[31:27] == 5'b00010);
+        X1_isFSUB    <= !isFMA && (instr_i[31:27] == 5'b00001);
+        X1_negProd   <= isFMA && instr_i[3];
+        X1_negAddend <= isFMA && instr_i[2];
+        X1_rm        <= rm_i;
+        X1_rs1       <= rs1_i;
+        X1_rs2       <= rs2_i;
+        X1_rs3       <= rs3_i;
+end
+
+/*-----------------X1: Multiply-------------------*/
+wire [31:0] rs1_s = X1_rs1[31:0];
+wire [31:0] rs2_s = X1_rs2[31:0];
+wire [31:0] rs3_s = X1_rs3[31:0];
+
+/******** Single Precision ********/
+wire        [5:0]  rs1Class;
+wire signed [9:0]  rs1Exp;
+wire        [23:0] rs1Sig;
+FClass class1(.reg_i(rs1_s), .regExp_o(rs1Exp), .regSig_o(rs1Sig),
+        .class_o(rs1Class), .fullClass_o());
+wire        [5:0]  rs2Class;
+wire signed [9:0]  rs2Exp;
+wire        [23:0] rs2Sig;
+FClass class2(.reg_i(rs2_s), .regExp_o(rs2Exp), .regSig_o(rs2Sig),
+        .class_o(rs2Class), .fullClass_o());
+wire        [5:0]  rs3Class;
+wire signed [9:0]  rs3Exp;
+wire        [23:0] rs3Sig;
+FClass class3(.reg_i(rs3_s), .regExp_o(rs3Exp), .regSig_o(rs3Sig),
+        .class_o(rs3Class), .fullClass_o());
+
+wire [31:0] fmulOut;
+// Keep unrounded output for FMA instructions
+wire        [47:0] fmulSig;
+wire signed [10:0] fmulExp;
+wire        [5:0]  fmulClass;
+FMUL fmul(
+        .rs1_i(rs1_s),
+        .rs1Exp_i(rs1Exp),
+        .rs1Sig_i(rs1Sig),
+        .rs1Class_i(rs1Class),
+        .rs2_i(rs2_s),
+        .rs2Exp_i(rs2Exp),
+        .rs2Sig_i(rs2Sig),
+        .rs2Class_i(rs2Class),
+        .rm_i(X1_rm),
+        .fmulOut_o(fmulOut),
+        .exp_o(fmulExp),
+        .sig_o(fmulSig),
+        .class_o(fmulClass)
+);
+
+// Need to Determine what inputs to use and negate the second one if subtracting
+// rs1 + rs2 for add/sub and mulOut + rs3 for madd/msub
+reg        [31:0] addRs1;
+reg        [47:0] addRs1Sig;
+reg signed [10:0] addRs1Exp;
+reg        [5:0]  addRs1Class;
+reg        [31:0] addRs2;
+reg        [47:0] addRs2Sig;
+reg signed [10:0] addRs2Exp;
+reg        [5:0]  addRs2Class;
+
+always @(*) begin
+        if (X1_isFMA) begin
+                addRs1      = X1_negProd ? {~fmulOut[31], fmulOut[30:0]} : fmulOut;
+                addRs1Sig   = fmulSig;
+                addRs1Exp   = fmulExp;
+                addRs1Class = fmulClass;
+
+                addRs2      = X1_negAddend ? {~rs3_s[31], rs3_s[30:0]} : rs3_s;
+                addRs2Sig   = {rs3Sig, 24'b0};
+                addRs2Exp   = {rs3Exp[9], rs3Exp};
+                addRs2Class = rs3Class;
+        end else begin
+                addRs1      = rs1_s;
+                addRs1Sig   = {rs1Sig, 24'b0};
+                addRs1Exp   = {rs1Exp[9], rs1Exp};
+                addRs1Class = rs1Class;
+
+                addRs2      = X1_isFSUB ? {~rs2_s[31], rs2_s[30:0]} : rs2_s;
+                addRs2Sig   = {rs2Sig, 24'b0};
+                addRs2Exp   = {rs2Exp[9], rs2Exp};
+                addRs2Class = rs2Class;
+        end
+end
+
+/******** Double Precision ********/
+wire        [5:0]  rs1Class_d;
+wire signed [12:0] rs1Exp_d;
+wire        [52:0] rs1Sig_d;
+FClass #(.FLen(64), .SigLen(52), .ExpLen(11)
+)class1_d(.reg_i(X1_rs1), .regExp_o(rs1Exp_d), .regSig_o(rs1Sig_d),
+        .class_o(rs1Class_d), .fullClass_o());
+wire        [5:0]  rs2Class_d;
+wire signed [12:0] rs2Exp_d;
+wire        [52:0] rs2Sig_d;
+FClass #(.FLen(64), .SigLen(52), .ExpLen(11)
+)class2_d(.reg_i(X1_rs2), .regExp_o(rs2Exp_d), .regSig_o(rs2Sig_d),
+        .class_o(rs2Class_d), .fullClass_o());
+wire        [5:0]  rs3Class_d;
+wire signed [12:0] rs3Exp_d;
+wire        [52:0] rs3Sig_d;
+FClass #(.FLen(64), .SigLen(52), .ExpLen(11)
+)class3_d(.reg_i(X1_rs3), .regExp_o(rs3Exp_d), .regSig_o(rs3Sig_d),
+        .class_o(rs3Class_d), .fullClass_o());
+
+wire [63:0] fmulOut_d;
+// Keep unrounded output for FMA instructions
+wire        [105:0] fmulSig_d;
+wire signed [13:0]  fmulExp_d;
+wire        [5:0]   fmulClass_d;
+FMUL #(
+        .FLEN(64)
+)fmul_d(
+        .rs1_i(X1_rs1),
+        .rs1Exp_i(rs1Exp_d),
+        .rs1Sig_i(rs1Sig_d),
+        .rs1Class_i(rs1Class_d),
+        .rs2_i(X1_rs2),
+        .rs2Exp_i(rs2Exp_d),
+        .rs2Sig_i(rs2Sig_d),
+        .rs2Class_i(rs2Class_d),
+        .rm_i(X1_rm),
+        .fmulOut_o(fmulOut_d),
+        .exp_o(fmulExp_d),
+        .sig_o(fmulSig_d),
+        .class_o(fmulClass_d)
+);
+
+reg        [63:0]  addRs1_d;
+reg        [105:0] addRs1Sig_d;
+reg signed [13:0]  addRs1Exp_d;
+reg        [5:0]   addRs1Class_d;
+reg        [63:0]  addRs2_d;
+reg        [105:0] addRs2Sig_d;
+reg signed [13:0]  addRs2Exp_d;
+reg        [5:0]   addRs2Class_d;
+
+always @(*) begin
+        if (X1_isFMA) begin
+                addRs1_d      = X1_negProd ? {~fmulOut_d[63], fmulOut_d[62:0]} : fmulOut_d;
+                addRs1Sig_d   = fmulSig_d;
+                addRs1Exp_d   = fmulExp_d;
+                addRs1Class_d = fmulClass_d;
+
+                addRs2_d      = X1_negAddend ? {~X1_rs3[63], X1_rs3[62:0]} : X1_rs3;
+                addRs2Sig_d   = {rs3Sig_d, 53'b0};
+                addRs2Exp_d   = {rs3Exp_d[12], rs3Exp_d};
+                addRs2Class_d = rs3Class_d;
+        end else begin
+                addRs1_d      = X1_rs1;
+                addRs1Sig_d   = {rs1Sig_d, 53'b0};
+                addRs1Exp_d   = {rs1Exp_d[12], rs1Exp_d};
+                addRs1Class_d = rs1Class_d;
+
+                addRs2_d      = X1_isFSUB ? {~X1_rs2[63], X1_rs2[62:0]} : X1_rs2;
+                addRs2Sig_d   = {rs2Sig_d, 53'b0};
+                addRs2Exp_d   = {rs2Exp_d[12], rs2Exp_d};
+                addRs2Class_d = rs2Class_d;
+        end
+end
+
+/*---------------X1/X2 Registers------------------*/
+reg         X2_valid = 1'b0;
+reg  [5:0]  X2_rdId;
+reg         X2_isD;
+reg         X2_isFMUL;
+reg  [2:0]  X2_rm;
+reg  [31:0] X2_fmulOut;
+reg  [63:0] X2_fmulOut_d;
+
+reg        [31:0]  X2_addRs1;
+reg        [47:0]  X2_addRs1Sig;
+reg signed [10:0]  X2_addRs1Exp;
+reg        [5:0]   X2_addRs1Class;
+reg        [31:0]  X2_addRs2;
+reg        [47:0]  X2_addRs2Sig;
+reg signed [10:0]  X2_addRs2Exp;
+reg        [5:0]   X2_addRs2Class;
+
+reg        [63:0]  X2_addRs1_d;
+reg        [105:0] X2_addRs1Sig_d;
+reg signed [13:0]  X2_addRs1Exp_d;
+reg        [5:0]   X2_addRs1Class_d;
+reg        [63:0]  X2_addRs2_d;
+reg        [105:0] X2_addRs2Sig_d;
+reg signed [13:0]  X2_addRs2Exp_d;
+reg        [5:0]   X2_addRs2Class_d;
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                X2_valid <= 1'b0;
+        end else begin
+                X2_valid <= X1_valid;
+        end
+
+        X2_rdId      <= X1_rdId;
+        X2_isD       <= X1_isD;
+        X2_isFMUL    <= X1_isFMUL;
+        X2_rm        <= X1_rm;
+        X2_fmulOut   <= fmulOut;
+        X2_fmulOut_d <= fmulOut_d;
+
+        X2_addRs1      <= addRs1;
+        X2_addRs1Sig   <= addRs1Sig;
+        X2_addRs1Exp   <= addRs1Exp;
+        X2_addRs1Class <= addRs1Class;
+        X2_addRs2      <= addRs2;
+        X2_addRs2Sig   <= addRs2Sig;
+        X2_addRs2Exp   <= addRs2Exp;
+        X2_addRs2Class <= addRs2Class;
+
+        X2_addRs1_d      <= addRs1_d;
+        X2_addRs1Sig_d   <= addRs1Sig_d;
+        X2_addRs1Exp_d   <= addRs1Exp_d;
+        X2_addRs1Class_d <= addRs1Class_d;
+        X2_addRs2_d      <= addRs2_d;
+        X2_addRs2Sig_d   <= addRs2Sig_d;
+        X2_addRs2Exp_d   <= addRs2Exp_d;
+        X2_addRs2Class_d <= addRs2Class_d;
+end
+
+/*--------------------X2: Add---------------------*/
+wire [31:0] faddOut;
+FADDd fadd(
+        .rs1_i(X2_addRs1),
+        .rs1Exp_i(X2_addRs1Exp),
+        .rs1Sig_i(X2_addRs1Sig),
+        .rs1Class_i(X2_addRs1Class),
+        .rs2_i(X2_addRs2),
+        .rs2Exp_i(X2_addRs2Exp),
+        .rs2Sig_i(X2_addRs2Sig),
+        .rs2Class_i(X2_addRs2Class),
+        .rm_i(X2_rm),
+        .faddOut_o(faddOut)
+);
+
+wire [63:0] faddOut_d;
+FADDd #(
+        .FLEN(64)
+)fadd_d(
+        .rs1_i(X2_addRs1_d),
+        .rs1Exp_i(X2_addRs1Exp_d),
+        .rs1Sig_i(X2_addRs1Sig_d),
+        .rs1Class_i(X2_addRs1Class_d),
+        .rs2_i(X2_addRs2_d),
+        .rs2Exp_i(X2_addRs2Exp_d),
+        .rs2Sig_i(X2_addRs2Sig_d),
+        .rs2Class_i(X2_addRs2Class_d),
+        .rm_i(X2_rm),
+        .faddOut_o(faddOut_d)
+);
+
+wire [63:0] X2_result =
+        X2_isD    ? (X2_isFMUL ? X2_fmulOut_d : faddOut_d) :
+                    {32'hFFFFFFFF, (X2_isFMUL ? X2_fmulOut : faddOut)};
+
+assign finishing_o = X2_valid;
+assign finishingRdId_o = X2_rdId;
+
+/*-----------------Result Register----------------*/
+initial resultValid_o = 1'b0;
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                resultValid_o <= 1'b0;
+        end else begin
+                resultValid_o <= X2_valid;
+        end
+
+        resultRdId_o <= X2_rdId;
+        result_o     <= X2_result;
+end
+
+endmodule
@@ -6,19 +6,21 @@
  *Created-------Monday Dec 22, 2025 13:51:51 UTC
  ************************************************/
 
-module FSQRT (
-        input  wire               clk_i,
-        input  wire               reset_i,
-        input  wire               sqrtEnable_i,
-
-        input  wire        [31:0] rs1_i,
-        input  wire signed [9:0]  rs1Exp_i,
-        input  wire        [23:0] rs1Sig_i,
-        input  wire        [5:0]  rs1Class_i,
-        input  wire        [2:0]  rm_i,
-
-        output reg                ready_o,
-        output wire        [31:0] fsqrtOut_o
+module FSQRT #(
+        parameter FLEN = 32
+)(
+        input  wire                     clk_i,
+        input  wire                     reset_i,
+        input  wire                     sqrtEnable_i,
+
+        input  wire        [FLEN-1:0]   rs1_i,
+        input  wire signed [NEXP+1:0]   rs1Exp_i,
+        input  wire        [NSIG:0]     rs1Sig_i,
+        input  wire        [5:0]        rs1Class_i,
+        input  wire        [2:0]        rm_i,
+
+        output reg                      ready_o,
+        output wire        [FLEN-1:0]   fsqrtOut_o
 );
 `ifdef BENCH
         `include "src/Processor/FPU/FClassFlags.vh"
@@ -26,30 +28,43 @@ module FSQRT (
         `include "../src/Processor/FPU/FClassFlags.vh"
 `endif
 
-reg [31:0] sqrtOut;
+localparam NEXP      = (FLEN == 32) ? 8 : 11;
+localparam NSIG      = (FLEN == 32) ? 23 : 52;
+localparam EMAX = ((1 << (NEXP - 1)) - 1);
+localparam BIAS = EMAX;
+localparam EMIN = 1 - EMAX;
+
+reg [FLEN-1:0] sqrtOut;
 assign fsqrtOut_o = sqrtOut;
 
 // Working registers
-reg signed [9:0]  expIn;
-reg signed [9:0]  qExp;
-reg [25:0] sqrtSig;
-reg [25:0] sqrtIn;
-reg [49:0] rootIn;
-
-reg [25:0] x;
-reg [25:0] xNext;
-reg [25:0] q;
-reg [25:0] qNext;
-reg [27:0] ac;
-reg [27:0] acNext;
-reg [27:0] test;
+reg signed [NEXP+1:0] expIn;
+reg signed [NEXP+1:0] qExp;
+reg [NSIG+2:0] sqrtSig;
+reg [2*NSIG+3:0] rootIn;
+
+reg [NSIG+2:0] x;
+reg [NSIG+2:0] xNext;
+reg [NSIG+2:0] q;
+reg [NSIG+2:0] qNext;
+reg [NSIG+4:0] ac;
+reg [NSIG+4:0] acNext;
+reg [NSIG+4:0] test;
+reg [NSIG+2:0] xStep;
+reg [NSIG+2:0] qStep;
+reg [NSIG+4:0] acStep;
+reg [NSIG+2:0] qLast;           // Root after the last cycle's steps
+reg [NSIG+4:0] acLast;
 
 // Cycle counter
-reg  [4:0] counter;
+reg  [5:0] counter;
 // Only one cycle is needed to handle special cases
-localparam SPECIAL_CYCLES = 5'b1;
-// Enough cycles to compute full significand with extra bits for rounding and normalizing
-localparam SQRT_CYCLES = 5'd26;
+localparam SPECIAL_CYCLES = 1;
+// The root needs NSIG + 2 steps for rounding and normalizing. Radix 4: two
+// steps per cycle, the cycle building rootIn takes the odd one if there is one.
+localparam LAST_STEPS = 2 - (NSIG % 2);
+localparam SQRT_CYCLES = (NSIG + 2 - LAST_STEPS) / 2 + 2;
+integer i;
 
 // Status Flags
 reg special;    // Special Cases (NaN, inf, zero)
@@ -57,12 +72,13 @@ reg busy;
 
 // A wire set to infinity or the max normal number depending on rounding modes
 wire si = (rm_i == 3'b001 || rm_i == 3'b010);
-wire [31:0] roundedInfinity = {1'b0, {7{1'b1}}, ~si, {23{si}}};
+wire [FLEN-1:0] roundedInfinity = {1'b0, {NEXP-1{1'b1}}, ~si, {NSIG{si}}};
 
 // Rounding
-wire        [23:0] sigOut;
-wire signed [9:0]  expOut;
-FRound #(.nInt(50)) round(1'b0, rootIn, expIn, rm_i, sigOut, expOut);
+wire        [NSIG:0]    sigOut;
+wire signed [NEXP+1:0]  expOut;
+FRound #(.nInt(2*NSIG+4), .nExp(NEXP), .nSig(NSIG)
+)round(1'b0, rootIn, expIn, rm_i, sigOut, expOut);
 
 always @(posedge clk_i) begin
         if (!sqrtEnable_i) begin
@@ -73,16 +89,16 @@ always @(posedge clk_i) begin
                 counter <= SPECIAL_CYCLES;
 
                 // initalize output
-                sqrtOut = 32'b0;
+                sqrtOut = 0;
 
                 /************************ Special Cases ************************/
                 // Propagate NaN and Zero (Zero keeps original sign)
                 if (|(rs1Class_i & 6'b110001)) begin
                         sqrtOut = rs1_i;
                 end
-                // Negatives are invalid and return qNaN
-                else if (rs1_i[31]) begin
-                        sqrtOut = {{10{1'b1}}, 22'b0};
+                // Negatives are invalid and return the canonical qNaN
+                else if (rs1_i[FLEN-1]) begin
+                        sqrtOut = {1'b0, {NEXP+1{1'b1}}, {NSIG-1{1'b0}}};
                 end
                 // Infinity returns infinity
                 else if (rs1Class_i[CLASS_BIT_INF]) begin
@@ -94,15 +110,15 @@ always @(posedge clk_i) begin
                         counter <= SQRT_CYCLES;
 
                         // Exponent gets halved
-                        expIn <= {rs1Exp_i[9], rs1Exp_i[9:1]};
+                        expIn <= {rs1Exp_i[NEXP+1], rs1Exp_i[NEXP+1:1]};
 
                         // Input into square root is significand with hidden bit
                         // If rs1Exp_i is odd, right shift by 1
                         q = 0;
                         sqrtSig = {1'b0, rs1Sig_i, 1'b0} >> rs1Exp_i[0];
-                        {ac, x} = {26'b0, sqrtSig, 2'b0};
+                        {ac, x} = {{NSIG+3{1'b0}}, sqrtSig, 2'b0};
 
-                        sqrtOut = {6'b0, q};
+                        sqrtOut = {{FLEN-(NSIG+3){1'b0}}, q};
                 end
         end else if (counter > 2) begin
                 counter <= counter - 1;
@@ -111,11 +127,12 @@ always @(posedge clk_i) begin
                 ac <= acNext;
                 q <= qNext;
 
-                sqrtOut <= {6'b0, qNext};
+                sqrtOut <= {{FLEN-(NSIG+3){1'b0}}, qNext};
         end else if (counter > 1) begin
                 counter <= counter - 1;
 
-                rootIn <= (rs1Exp_i[0]) ? {qNext[23:0], acNext[27:2]} : {qNext[24:1], acNext[27:2]};
+                rootIn <= (rs1Exp_i[0]) ? {qLast[NSIG:0], acLast[NSIG+4:2]} :
+                                          {qLast[NSIG+1:1], acLast[NSIG+4:2]};
         end else if (counter > 0) begin // Construct final output
                 counter <= counter - 1;
 
@@ -124,14 +141,14 @@ always @(posedge clk_i) begin
                         // Zero
                         if (~|sigOut) begin
                                 // Negative zero if rounding mode is towards -infinity
-                                sqrtOut <= {rm_i == 3'b010, 31'b0};
+                                sqrtOut <= {rm_i == 3'b010, {FLEN-1{1'b0}}};
                         end
                         // Subnormal
-                        else if (expOut < -126) begin
-                                sqrtOut <= {9'b0, sigOut[22:0]};
+                        else if (expOut < EMIN) begin
+                                sqrtOut <= {1'b0, {NEXP{1'b0}}, sigOut[NSIG-1:0]};
                         end
                         // Overflow
-                        else if (expOut > 127) begin
+                        else if (expOut > EMAX) begin
                                 // // Round to infinity or largest normal depending on rounding mode
                                 // si = (rm_i == 3'b001 || 
                                 //         (rm_i == 3'b010 && ~qSign) ||
@@ -141,23 +158,38 @@ always @(posedge clk_i) begin
                         end
                         // Normal
                         else begin
-                                qExp = expOut + 127;
-                                sqrtOut = {1'b0, qExp[7:0], sigOut[22:0]};
+                                qExp = expOut + BIAS;
+                                sqrtOut = {1'b0, qExp[NEXP-1:0], sigOut[NSIG-1:0]};
                         end
                 end
                 special <= 1'b0;
         end
 end
 
+// Two steps of the digit by digit root per cycle
 always @(*) begin
-        test = ac - {q, 2'b01};
-        if (test[27] == 0) begin
-                {acNext, xNext} = {test[25:0], x, 2'b0};
-                qNext = {q[24:0], 1'b1};
-        end else begin
-                {acNext, xNext} = {ac[25:0], x, 2'b0};
-                qNext = q << 1;
+        acStep = ac;
+        xStep  = x;
+        qStep  = q;
+        qLast  = q;
+        acLast = ac;
+        for (i = 0; i < 2; i = i + 1) begin
+                test = acStep - {qStep, 2'b01};
+                if (test[NSIG+4] == 0) begin
+                        {acStep, xStep} = {test[NSIG+2:0], xStep, 2'b0};
+                        qStep = {qStep[NSIG+1:0], 1'b1};
+                end else begin
+                        {acStep, xStep} = {acStep[NSIG+2:0], xStep, 2'b0};
+                        qStep = qStep << 1;
+                end
+                if (i < LAST_STEPS) begin
+                        qLast  = qStep;
+                        acLast = acStep;
+                end
         end
+        acNext = acStep;
+        xNext  = xStep;
+        qNext  = qStep;
 end
 
 // Logic to generate the busy signal
@@ -0,0 +1,208 @@
+/*************************************************
+ *File----------ICache.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Sunday Oct 18, 2026 21:12:05 UTC
+ ************************************************/
+/* verilator lint_off WIDTH */
+
+module ICache #(
+        parameter SIZE = 4096,  // Bytes
+        parameter LINE = 16,    // Bytes per line (at least 8)
+        parameter WAYS = 2      // Power of 2
+)(
+        input  wire        clk_i,
+        input  wire        reset_i,
+        // Fetch Unit Interface
+        input  wire [31:0] addr_i,
+        input  wire        fetch_i,         // Fetch unit takes the instruction this cycle
+        output wire [31:0] instr_o,
+        output wire        valid_o,
+        output wire [31:0] instr2_o,        // Instruction after instr_o (fusion)
+        output wire        valid2_o,
+        input  wire        invalidate_i,    // FENCE.I
+        // Address Translation
+        // addr_i is virtual. The MMU supplies the physical pages of addr_i
+        // and of the page after it, for a window that crosses the boundary.
+        input  wire [19:0] pageA_i,
+        input  wire [19:0] pageB_i,
+        input  wire [1:0]  pageValid_i,     // {pageB_i, pageA_i} translated
+        output wire        xlateMiss_o,     // Needed halfword is on a page not translated
+        output wire [31:0] xlateAddr_o,
+        // External Memory Interface
+        // A request reads memReqLen_o words, starting at memReqAddr_o and
+        // wrapping around the aligned block. One word is returned per response.
+        output wire        memReqValid_o,
+        input  wire        memReqReady_i,
+        output wire [31:0] memReqAddr_o,
+        output wire [7:0]  memReqLen_o,
+        input  wire        memRespValid_i,
+        input  wire [31:0] memRespData_i
+);
+
+/*
+ * Set associative instruction cache with a combinational read, so a hit
+ * fetches in the same cycle as the old instruction memory.
+ * Instructions are 16 bit aligned, so a 32 bit instruction in the last
+ * halfword of a line also needs the next line. The three words covering a
+ * two instruction window are looked up each cycle. The instruction is valid
+ * once every halfword it needs is present. The instruction after it is
+ * returned for macro-op fusion when it is present, but never refilled.
+ * A miss refills one line, critical word first. Words of the line being
+ * refilled can be fetched as soon as they arrive.
+ * Lines are physically tagged. A word on a page the MMU has not translated
+ * misses, and the fetch waits for the page walk instead of a refill.
+ */
+
+localparam LINE_WORDS = LINE / 4;
+localparam SETS       = SIZE / (LINE * WAYS);
+localparam OFF_BITS   = $clog2(LINE);
+localparam WORD_BITS  = $clog2(LINE_WORDS);
+localparam SET_BITS   = $clog2(SETS);
+localparam TAG_BITS   = 32 - OFF_BITS - SET_BITS;
+localparam WAY_BITS   = (WAYS > 1) ? $clog2(WAYS) : 1;
+
+reg [31:0]          data [0:WAYS*SETS*LINE_WORDS-1];
+reg [TAG_BITS-1:0]  tags [0:WAYS*SETS-1];
+reg [WAYS*SETS-1:0] lineValid = 0;
+reg [WAY_BITS-1:0]  victim = 0;         // Round robin replacement
+
+/*verilator public_flat_rw_on*/
+reg [31:0] hitCount = 0;                // Fetches that hit
+reg [31:0] missCount = 0;               // Line refills
+reg [31:0] missCycles = 0;              // Cycles fetch waited on a refill
+/*verilator public_off*/
+
+/*--------------------REFILL----------------------*/
+reg                      refillActive = 1'b0;
+reg                      refillReq = 1'b0;      // Request not yet accepted
+reg                      refillStale;           // Invalidated during refill
+reg  [31-OFF_BITS:0]     refillLine;
+reg  [WAY_BITS-1:0]      refillWay;
+reg  [WORD_BITS-1:0]     refillWord;            // Word of the next response
+reg  [WORD_BITS:0]       refillCount;
+reg  [LINE_WORDS-1:0]    refillWordValid;
+
+wire [SET_BITS-1:0] refillSet = refillLine[SET_BITS-1:0];
+
+/*--------------------LOOKUP----------------------*/
+// Words at addr, addr+4 and addr+8 (word aligned)
+wire [31:0] wordAddr = {addr_i[31:2], 2'b00};
+
+reg [2:0]  wordHit;
+reg [95:0] words;
+reg [31:0] kAddr;
+reg        kOnB;
+integer w, k;
+always @(*) begin
+        wordHit = 3'b0;
+        words   = 96'b0;
+        for (k = 0; k < 3; k = k + 1) begin
+                kAddr = wordAddr + 4*k;
+                kOnB  = (kAddr[31:12] != addr_i[31:12]);
+                kAddr = {kOnB ? pageB_i : pageA_i, kAddr[11:0]};
+                for (w = 0; w < WAYS; w = w + 1) begin
+                        if ((kOnB ? pageValid_i[1] : pageValid_i[0]) &&
+                                        lineValid[w*SETS + kAddr[OFF_BITS+SET_BITS-1:OFF_BITS]] &&
+                                        (tags[w*SETS + kAddr[OFF_BITS+SET_BITS-1:OFF_BITS]] ==
+                                         kAddr[31:OFF_BITS+SET_BITS])) begin
+                                wordHit[k] = 1'b1;
+                                words[k*32 +: 32] = data[(w*SETS + kAddr[OFF_BITS+SET_BITS-1:OFF_BITS])*LINE_WORDS +
+                                                         kAddr[OFF_BITS-1:2]];
+                        end
+                end
+
+                // Early restart from the line being refilled
+                if (refillActive && !refillStale && (kAddr[31:OFF_BITS] == refillLine) &&
+                                (kOnB ? pageValid_i[1] : pageValid_i[0]) &&
+                                refillWordValid[kAddr[OFF_BITS-1:2]]) begin
+                        wordHit[k] = 1'b1;
+                        words[k*32 +: 32] = data[{refillWay, refillSet, kAddr[OFF_BITS-1:2]}];
+                end
+        end
+end
+
+// Four halfwords starting at addr_i
+wire [63:0] window   = addr_i[1] ? words[79:16] : words[63:0];
+wire [3:0]  halfHit  = addr_i[1] ? {wordHit[2], wordHit[1], wordHit[1], wordHit[0]} :
+                                   {wordHit[1], wordHit[1], wordHit[0], wordHit[0]};
+
+wire        isCompressed  = ~(&window[1:0]);
+wire [47:0] window2       = isCompressed ? window[63:16] : {16'b0, window[63:32]};
+wire [2:0]  halfHit2      = isCompressed ? halfHit[3:1]  : {1'b0, halfHit[3:2]};
+wire        isCompressed2 = ~(&window2[1:0]);
+
+assign instr_o  = window[31:0];
+assign valid_o  = halfHit[0] && (isCompressed || halfHit[1]);
+assign instr2_o = window2[31:0];
+assign valid2_o = halfHit2[0] && (isCompressed2 || halfHit2[1]);
+
+wire [31:0] loAddr = addr_i;
+wire [31:0] hiAddr = addr_i + 2;
+
+// Refill the line of the first missing halfword once its page is translated
+wire [31:0] missAddr  = halfHit[0] ? hiAddr : loAddr;
+wire        missOnB   = (missAddr[31:12] != addr_i[31:12]);
+wire        missXlate = missOnB ? pageValid_i[1] : pageValid_i[0];
+wire [31:0] missPAddr = {missOnB ? pageB_i : pageA_i, missAddr[11:0]};
+wire        refillStart = !valid_o && missXlate && !refillActive && !invalidate_i && !reset_i;
+
+assign xlateMiss_o = !valid_o && !missXlate;
+assign xlateAddr_o = missAddr;
+
+assign memReqValid_o = refillReq;
+assign memReqAddr_o  = {refillLine, refillWord, 2'b00};
+assign memReqLen_o   = LINE_WORDS;
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                refillActive <= 1'b0;
+                refillReq    <= 1'b0;
+        end else if (refillStart) begin
+                refillActive    <= 1'b1;
+                refillReq       <= 1'b1;
+                refillStale     <= 1'b0;
+                refillLine      <= missPAddr[31:OFF_BITS];
+                refillWay       <= victim;
+                refillWord      <= missPAddr[OFF_BITS-1:2];
+                refillCount     <= 0;
+                refillWordValid <= 0;
+                victim          <= (WAYS > 1) ? victim + 1 : 0;
+
+                // The way is invalid until the whole line is written
+                lineValid[{victim, missPAddr[OFF_BITS+SET_BITS-1:OFF_BITS]}] <= 1'b0;
+                tags[{victim, missPAddr[OFF_BITS+SET_BITS-1:OFF_BITS]}] <=
+                        missPAddr[31:OFF_BITS+SET_BITS];
+                missCount <= missCount + 1;
+        end else if (refillActive) begin
+                if (memReqReady_i) begin
+                        refillReq <= 1'b0;
+                end
+                if (memRespValid_i && !refillReq) begin
+                        data[{refillWay, refillSet, refillWord}] <= memRespData_i;
+                        refillWordValid[refillWord] <= 1'b1;
+                        refillWord  <= refillWord + 1;
+                        refillCount <= refillCount + 1;
+                        if (refillCount == LINE_WORDS - 1) begin
+                                refillActive <= 1'b0;
+                                lineValid[{refillWay, refillSet}] <= !refillStale;
+                        end
+                end
+        end
+
+        if (invalidate_i) begin
+                lineValid   <= 0;
+                refillStale <= 1'b1;
+        end
+
+        if (fetch_i && valid_o) begin
+                hitCount <= hitCount + 1;
+        end
+        if (fetch_i && !valid_o) begin
+                missCycles <= missCycles + 1;
+        end
+end
+
+endmodule
+/* verilator lint_on WIDTH */
@@ -0,0 +1,139 @@
+/*************************************************
+ *File----------IDIV.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Sunday Oct 18, 2026 18:02:11 UTC
+ ************************************************/
+
+module IDIV (
+        input  wire        clk_i,
+        input  wire        reset_i,
+        input  wire        divEnable_i,
+        input  wire        resultAck_i,
+
+        input  wire [2:0]  funct3_i,    // DIV, DIVU, REM, REMU
+        input  wire [31:0] rs1_i,
+        input  wire [31:0] rs2_i,
+
+        output wire        busy_o,
+        output wire        ready_o,
+        output wire [31:0] divOut_o
+);
+
+/*
+ * Radix-4 restoring divider
+ * Each iteration shifts 2 dividend bits into the partial remainder and
+ * compares it against 1x, 2x and 3x the divisor to produce a quotient digit.
+ * Leading zeros of the dividend beyond the width of the quotient are skipped,
+ * so the number of iterations is ceil(quotientBits / 2) (16 worst case).
+ * Division by zero, power of 2 divisors (including 1) and a dividend smaller
+ * than the divisor are resolved in the first cycle.
+ * The result is held with ready_o set until it is acknowledged.
+ */
+
+// Absolute value of the operands for signed divides
+wire divSigned = ~funct3_i[0];
+wire [31:0] absRs1 = divSigned & rs1_i[31] ? -rs1_i : rs1_i;
+wire [31:0] absRs2 = divSigned & rs2_i[31] ? -rs2_i : rs2_i;
+
+wire [4:0] rs1Clz;
+wire [4:0] rs2Clz;
+CLZ #(.W_IN(32)) clz1(absRs1, rs1Clz);
+CLZ #(.W_IN(32)) clz2(absRs2, rs2Clz);
+
+// Working registers
+reg [31:0] dividend;    // Dividend bits not yet shifted into the remainder
+reg [31:0] remainder;
+reg [31:0] quotient;
+reg [31:0] divisor;
+reg [33:0] divisor3;
+reg [4:0]  counter;
+reg        busy = 1'b0;
+reg        ready = 1'b0;
+reg        isRem;
+reg        sign;
+
+/*verilator public_flat_rw_on*/
+wire       divStart = divEnable_i & ~busy & ~ready & ~reset_i;
+wire       divByZero  = (absRs2 == 0);
+wire       divByPow2  = ~divByZero & ((absRs2 & (absRs2 - 1)) == 0);
+wire       divSmall   = (absRs1 < absRs2);
+wire       divFast    = divByZero | divByPow2 | divSmall;
+// Quotient has at most rs2Clz - rs1Clz + 1 bits, 2 bits per iteration
+wire [5:0] divIters   = ({1'b0, rs2Clz} - {1'b0, rs1Clz} + 6'd2) >> 1;
+wire [5:0] dividendBits = (absRs1 == 0) ? 6'd0 : 6'd32 - {1'b0, rs1Clz};
+wire [5:0] divisorBits  = divByZero     ? 6'd0 : 6'd32 - {1'b0, rs2Clz};
+/*verilator public_off*/
+
+wire [5:0] divShamt = {divIters[4:0], 1'b0};
+wire [4:0] pow2Shamt = 5'd31 - rs2Clz;
+
+// Radix-4 iteration
+wire [33:0] rShift = {remainder, dividend[31:30]};
+wire [34:0] diff1  = {1'b0, rShift} - {3'b0, divisor};
+wire [34:0] diff2  = {1'b0, rShift} - {2'b0, divisor, 1'b0};
+wire [34:0] diff3  = {1'b0, rShift} - {1'b0, divisor3};
+
+wire [1:0]  qDigit =
+        !diff3[34] ? 2'd3 :
+        !diff2[34] ? 2'd2 :
+        !diff1[34] ? 2'd1 : 2'd0;
+wire [31:0] rNext =
+        !diff3[34] ? diff3[31:0] :
+        !diff2[34] ? diff2[31:0] :
+        !diff1[34] ? diff1[31:0] : rShift[31:0];
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                busy <= 1'b0;
+                ready <= 1'b0;
+                counter <= 0;
+        end else if (resultAck_i) begin
+                ready <= 1'b0;
+        end else if (divStart) begin
+                isRem <= funct3_i[1];
+                sign <= divSigned & (funct3_i[1] ? rs1_i[31] :
+                        (rs1_i[31] != rs2_i[31]) & ~divByZero);
+                divisor <= absRs2;
+                divisor3 <= {2'b0, absRs2} + {1'b0, absRs2, 1'b0};
+
+                if (divByZero) begin
+                        quotient <= 32'hFFFFFFFF;
+                        remainder <= absRs1;
+                end else if (divByPow2) begin
+                        quotient <= absRs1 >> pow2Shamt;
+                        remainder <= absRs1 & (absRs2 - 1);
+                end else if (divSmall) begin
+                        quotient <= 32'b0;
+                        remainder <= absRs1;
+                end else begin
+                        // Skip the leading zeros of the dividend
+                        quotient <= 32'b0;
+                        remainder <= absRs1 >> divShamt;
+                        dividend <= absRs1 << (6'd32 - divShamt);
+                        counter <= divIters[4:0];
+                end
+
+                busy <= ~divFast;
+                ready <= divFast;
+        end else if (busy) begin
+                dividend <= dividend << 2;
+                remainder <= rNext;
+                quotient <= {quotient[29:0], qDigit};
+                counter <= counter - 1;
+
+                if (counter == 1) begin
+                        busy <= 1'b0;
+                        ready <= 1'b1;
+                end
+        end
+end
+
+assign busy_o = busy;
+assign ready_o = ready;
+assign divOut_o =
+        isRem ? (sign ? -remainder : remainder) :
+                (sign ? -quotient  : quotient);
+
+endmodule
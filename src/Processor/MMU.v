@@ -0,0 +1,291 @@
+/*************************************************
+ *File----------MMU.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 04:31:09 UTC
+ ************************************************/
+/* verilator lint_off WIDTH */
+
+module MMU #(
+        parameter ITLB_ENTRIES = 8,
+        parameter DTLB_ENTRIES = 8
+)(
+        input  wire        clk_i,
+        input  wire        reset_i,
+        // Translation Control
+        input  wire [31:0] csrSatp_i,
+        input  wire [63:0] csrMStatus_i,
+        input  wire [1:0]  privilege_i,         // Loads and stores
+        input  wire [1:0]  fetchPrivilege_i,    // Fetch, after a trap/return in decode
+        input  wire        sfence_i,            // SFENCE.VMA leaving execute
+        input  wire [31:0] sfenceAddr_i,
+        input  wire [8:0]  sfenceAsid_i,
+        input  wire        sfenceAllAddr_i,     // rs1 = x0
+        input  wire        sfenceAllAsid_i,     // rs2 = x0
+        input  wire        satpWrite_i,         // satp write leaving execute
+        input  wire        trapTaken_i,         // Trap or return in decode
+        // Instruction Side (Instruction Cache)
+        input  wire [31:0] iAddr_i,
+        input  wire        iFetch_i,            // Fetch takes an instruction
+        output wire [19:0] iPageA_o,
+        output wire [19:0] iPageB_o,
+        output wire [1:0]  iPageValid_o,
+        input  wire        iMiss_i,             // Fetch needs a page not translated
+        input  wire [31:0] iMissAddr_i,
+        output wire        iFault_o,            // Instruction page fault at iMissAddr_i
+        // Data Side (Execute Unit)
+        input  wire        dValid_i,            // Load, store or AMO in execute
+        input  wire        dRead_i,
+        input  wire        dWrite_i,
+        input  wire        dAccept_i,           // Execute advances
+        input  wire [31:0] dAddr_i,
+        output wire [31:0] dPAddr_o,
+        output wire        dWait_o,             // Translation not ready yet
+        output wire        dFault_o,            // Load/store page fault
+        input  wire        rEnable_i,
+        input  wire        rDouble_i,
+        output wire        rValid_o,
+        // Data Cache Read Port
+        output wire [31:0] cacheRAddr_o,
+        output wire        cacheREnable_o,
+        output wire        cacheRDouble_o,
+        input  wire [63:0] cacheRData_i,
+        input  wire        cacheRValid_i
+);
+
+/*
+ * Sv32 address translation with separate I-TLB and D-TLB and a hardware page
+ * table walker. Translation is on when satp.MODE is set below machine mode
+ * (mstatus.MPRV selects MPP for loads and stores).
+ * The walker reads PTEs through the data cache read port, so they are cached
+ * and see stores still in the store buffer. While it walks, execute cannot use
+ * the port. D-TLB misses are walked before I-TLB misses.
+ * A and D are not updated in hardware: an access to a page with A clear, or a
+ * store to a page with D clear, raises a page fault (Svade).
+ * A walk that ends in a fault is remembered by page until the next trap,
+ * SFENCE.VMA or satp write, so the access faults instead of walking again.
+ * A satp write does not flush the TLBs, entries are tagged with the ASID and
+ * software runs SFENCE.VMA before it reuses an ASID or changes a mapping.
+ */
+
+localparam US = 2'b00, SU = 2'b01, MA = 2'b11;
+
+wire        satpMode = csrSatp_i[31];
+wire [8:0]  satpAsid = csrSatp_i[30:22];
+wire [19:0] satpPpn  = csrSatp_i[19:0];
+
+wire mprv = csrMStatus_i[17];
+wire sum  = csrMStatus_i[18];
+wire mxr  = csrMStatus_i[19];
+wire [1:0] dPrivilege = ((privilege_i == MA) && mprv) ? csrMStatus_i[12:11] : privilege_i;
+
+wire iOn = satpMode && (fetchPrivilege_i != MA);
+wire dOn = satpMode && (dPrivilege != MA);
+
+/*verilator public_flat_rw_on*/
+reg [31:0] itlbHitCount = 0;            // Fetches translated by the I-TLB
+reg [31:0] itlbMissCount = 0;           // Page walks for fetch
+reg [31:0] dtlbHitCount = 0;            // Loads/stores translated by the D-TLB
+reg [31:0] dtlbMissCount = 0;           // Page walks for loads/stores
+reg [31:0] walkCycles = 0;              // Cycles the walker used the data cache port
+reg [31:0] pageFaultCount = 0;          // Walks that ended in a page fault
+/*verilator public_off*/
+
+// Access allowed by PTE flags {D, A, G, U, X, W, R, V}
+function permOk;
+        input [7:0] pte;
+        input [1:0] priv;
+        input       fetch;
+        input       read;
+        input       write;
+        begin
+                permOk = pte[6] &&
+                        ((priv == US) ? pte[4] : (!pte[4] || (sum && !fetch))) &&
+                        (!fetch || pte[3]) &&
+                        (!read  || pte[1] || (mxr && pte[3])) &&
+                        (!write || (pte[2] && pte[7]));
+        end
+endfunction
+
+/*--------------------WALKER----------------------*/
+localparam W_IDLE = 2'd0;
+localparam W_L1   = 2'd1;
+localparam W_L0   = 2'd2;
+
+reg [1:0]  wState = W_IDLE;
+reg        wData;               // Walk for the data side
+reg        wStale;              // TLBs flushed or satp written during the walk
+reg [19:0] wVpn;
+reg [31:0] wAddr;               // Address of the PTE being read
+
+wire walking = (wState != W_IDLE);
+
+wire [31:0] pte      = cacheRData_i[31:0];
+wire        pteDone  = walking && cacheRValid_i;
+wire        pteLeaf  = pte[1] || pte[3];
+// Invalid, W without R, a misaligned megapage, or no leaf at level 0
+wire        pteFault = !pte[0] || (!pte[1] && pte[2]) ||
+        (pteLeaf ? ((wState == W_L1) && (pte[19:10] != 10'b0)) : (wState == W_L0));
+wire        wFill    = pteDone && pteLeaf && !pteFault && !wStale;
+
+/*--------------------I-TLB-----------------------*/
+wire [19:0] iVpnA = iAddr_i[31:12];
+wire [19:0] iVpnB = iVpnA + 1;
+wire        itHitA, itHitB;
+wire [19:0] itPpnA, itPpnB;
+wire [7:0]  itFlagsA, itFlagsB;
+
+TLB #(
+        .ENTRIES(ITLB_ENTRIES)
+)itlb(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .asid_i(satpAsid),
+        .vpnA_i(iVpnA),
+        .hitA_o(itHitA),
+        .ppnA_o(itPpnA),
+        .flagsA_o(itFlagsA),
+        .vpnB_i(iVpnB),
+        .hitB_o(itHitB),
+        .ppnB_o(itPpnB),
+        .flagsB_o(itFlagsB),
+        .fill_i(wFill && !wData),
+        .fillVpn_i(wVpn),
+        .fillPpn_i(pte[29:10]),
+        .fillFlags_i(pte[7:0]),
+        .fillMega_i(wState == W_L1),
+        .flush_i(sfence_i),
+        .flushVpn_i(sfenceAddr_i[31:12]),
+        .flushAsid_i(sfenceAsid_i),
+        .flushAllVpn_i(sfenceAllAddr_i),
+        .flushAllAsid_i(sfenceAllAsid_i)
+);
+
+assign iPageA_o     = iOn ? itPpnA : iVpnA;
+assign iPageB_o     = iOn ? itPpnB : iVpnB;
+assign iPageValid_o = iOn ? {itHitB && permOk(itFlagsB, fetchPrivilege_i, 1'b1, 1'b0, 1'b0),
+                             itHitA && permOk(itFlagsA, fetchPrivilege_i, 1'b1, 1'b0, 1'b0)} :
+                            2'b11;
+
+reg         iFaultValid = 1'b0;
+reg  [19:0] iFaultVpn;
+
+// A page in the I-TLB that is still missing failed its permission check
+wire iMissHit  = (iMissAddr_i[31:12] == iVpnA) ? itHitA : itHitB;
+wire iFaultHit = iFaultValid && (iFaultVpn == iMissAddr_i[31:12]);
+assign iFault_o = iOn && iMiss_i && (iMissHit || iFaultHit);
+wire iWalkReq   = iOn && iMiss_i && !iMissHit && !iFaultHit;
+
+/*--------------------D-TLB-----------------------*/
+wire [19:0] dVpn = dAddr_i[31:12];
+wire        dtHit;
+wire [19:0] dtPpn;
+wire [7:0]  dtFlags;
+
+TLB #(
+        .ENTRIES(DTLB_ENTRIES)
+)dtlb(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .asid_i(satpAsid),
+        .vpnA_i(dVpn),
+        .hitA_o(dtHit),
+        .ppnA_o(dtPpn),
+        .flagsA_o(dtFlags),
+        .vpnB_i(20'b0),
+        .hitB_o(),
+        .ppnB_o(),
+        .flagsB_o(),
+        .fill_i(wFill && wData),
+        .fillVpn_i(wVpn),
+        .fillPpn_i(pte[29:10]),
+        .fillFlags_i(pte[7:0]),
+        .fillMega_i(wState == W_L1),
+        .flush_i(sfence_i),
+        .flushVpn_i(sfenceAddr_i[31:12]),
+        .flushAsid_i(sfenceAsid_i),
+        .flushAllVpn_i(sfenceAllAddr_i),
+        .flushAllAsid_i(sfenceAllAsid_i)
+);
+
+reg         dFaultValid = 1'b0;
+reg  [19:0] dFaultVpn;
+
+wire dXlate    = dValid_i && dOn;
+wire dFaultHit = dFaultValid && (dFaultVpn == dVpn);
+wire dOk       = permOk(dtFlags, dPrivilege, 1'b0, dRead_i, dWrite_i);
+
+assign dPAddr_o = dOn ? {dtPpn, dAddr_i[11:0]} : dAddr_i;
+assign dFault_o = dXlate && (dtHit ? !dOk : dFaultHit);
+assign dWait_o  = dXlate && !dtHit && !dFaultHit;
+wire   dWalkReq = dWait_o;
+
+/*--------------------DATA PORT-------------------*/
+assign cacheRAddr_o   = walking ? wAddr : dPAddr_o;
+assign cacheREnable_o = walking || rEnable_i;
+assign cacheRDouble_o = !walking && rDouble_i;
+assign rValid_o       = !walking && cacheRValid_i;
+
+/*------------------------------------------------*/
+wire wStart = !walking && (dWalkReq || iWalkReq) && !reset_i;
+wire flush  = sfence_i || satpWrite_i;
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                wState      <= W_IDLE;
+                iFaultValid <= 1'b0;
+                dFaultValid <= 1'b0;
+        end else begin
+                if (flush || trapTaken_i) begin
+                        iFaultValid <= 1'b0;
+                        dFaultValid <= 1'b0;
+                end
+
+                case (wState)
+                W_IDLE: if (wStart) begin
+                        wState <= W_L1;
+                        wData  <= dWalkReq;
+                        wStale <= flush;
+                        wVpn   <= dWalkReq ? dVpn : iMissAddr_i[31:12];
+                        wAddr  <= {satpPpn, dWalkReq ? dVpn[19:10] : iMissAddr_i[31:22], 2'b00};
+                        if (dWalkReq)
+                                dtlbMissCount <= dtlbMissCount + 1;
+                        else
+                                itlbMissCount <= itlbMissCount + 1;
+                end
+                W_L1, W_L0: begin
+                        if (flush)
+                                wStale <= 1'b1;
+                        if (pteDone) begin
+                                if (pteFault || pteLeaf) begin
+                                        wState <= W_IDLE;
+                                end else begin
+                                        wState <= W_L0;
+                                        wAddr  <= {pte[29:10], wVpn[9:0], 2'b00};
+                                end
+                                if (pteFault && !wStale) begin
+                                        if (wData) begin
+                                                dFaultValid <= 1'b1;
+                                                dFaultVpn   <= wVpn;
+                                        end else begin
+                                                iFaultValid <= 1'b1;
+                                                iFaultVpn   <= wVpn;
+                                        end
+                                        pageFaultCount <= pageFaultCount + 1;
+                                end
+                        end
+                        walkCycles <= walkCycles + 1;
+                end
+                default: wState <= W_IDLE;
+                endcase
+        end
+
+        if (iOn && iFetch_i)
+                itlbHitCount <= itlbHitCount + 1;
+        if (dXlate && dtHit && dAccept_i)
+                dtlbHitCount <= dtlbHitCount + 1;
+end
+
+endmodule
+/* verilator lint_on WIDTH */
@@ -7,9 +7,11 @@
  ************************************************/
 
 module DecodeUnit #(
-        parameter BP_ADDR_BITS = 12,
+        parameter BP_ADDR_BITS = 14,
         parameter BHT_SIZE = 1 << BP_ADDR_BITS,
-        parameter BH_BITS = 9
+        parameter BH_BITS = 9,
+        parameter FUSE = 5'b11111,      // Enabled fusion pairs, see MACRO-OP FUSION
+        parameter DUAL = 1              // Issue a second ALU op, see SECOND ISSUE LANE
 )(
         input  wire        clk_i,
         input  wire        reset_i,
@@ -23,30 +25,61 @@ module DecodeUnit #(
         output wire [31:0] D_PCprediction_o,
         output wire        dataHazard_o,
         output wire        D_isPrivileged_o,
+        output wire        longHazard_o,
+        output wire        csrHazard_o,
+        output wire        loadUseStall_o,
+        // Long Latency Ops
+        input  wire        E_longIssue_i,
+        input  wire        E_longDone_i,
+        input  wire [5:0]  E_longDoneRdId_i,
+        input  wire        E_fpPipeDone_i,
+        input  wire [5:0]  E_fpPipeDoneRdId_i,
+        // Page Faults (Execute Unit)
+        input  wire        E_exc_i,
+        input  wire [4:0]  E_excCause_i,
+        input  wire [31:0] E_excTval_i,
+        // Address Translation
+        output wire [1:0]  D_privilege_o,
+        output wire [1:0]  D_fetchPrivilege_o,
         // CSR Interface
         input  wire [63:0] csrMStatus_i,
         input  wire [63:0] csrMedeleg_i,
+        input  wire [31:0] csrMideleg_i,
+        input  wire [31:0] csrMip_i,
+        input  wire [31:0] csrMie_i,
         input  wire [31:0] csrMtvec_i,
         input  wire [31:0] csrMepc_i,
         input  wire [31:0] csrMCause_i,
+        input  wire [31:0] csrMtval_i,
         input  wire [31:0] csrStvec_i,
         input  wire [31:0] csrSepc_i,
         input  wire [31:0] csrSCause_i,
+        input  wire [31:0] csrStval_i,
         output wire [6:0]  csrMStatusSet_o, // {MPP[1:0], MPIE, MIE, SPP, SPIE, SIE}
         output wire [31:0] csrMepcSet_o,
         output wire [31:0] csrMCauseSet_o,
+        output wire [31:0] csrMtvalSet_o,
         output wire [31:0] csrSepcSet_o,
         output wire [31:0] csrSCauseSet_o,
+        output wire [31:0] csrStvalSet_o,
         output wire        csrTrapSetEn_o,
         // Fetch Unit Interface
+        input  wire [31:0] F_nextPC_i,          // PC entering decode next, indexes the BHT
         input  wire [31:0] FD_PC_i,
-        input  wire [31:0] FD_instr_i,
+        input  wire [31:0] FD_instr_i,          // Decompressed in fetch
         input  wire        FD_isRV32C_i,
+        input  wire [7:0]  FD_predecode_i,
+        input  wire [31:0] FD_instr2_i,
+        input  wire        FD_instr2IsRV32C_i,
+        input  wire        FD_instr2Valid_i,
+        input  wire        FD_fault_i,          // Instruction page fault
+        input  wire [31:0] FD_faultAddr_i,
         input  wire        FD_nop_i,
         // Execute Unit Interface
         output reg  [31:0] DE_PC_o,
         output reg  [31:0] DE_instr_o,
         output reg         DE_isRV32C_o,
+        output reg         DE_isFused_o,
         output reg         DE_nop_o,
         output reg         DE_isLUI_o,
         output reg         DE_isAUIPC_o,
@@ -76,12 +109,19 @@ module DecodeUnit #(
         output reg  [31:0] DE_Bimm_o,
         output reg  [31:0] DE_Uimm_o,
         output reg         DE_isRV32M_o,
+        output reg         DE_isBitManip_o,
         output reg         DE_isMUL_o,
         output reg         DE_isDIV_o,
+        output reg         DE_isLongOp_o,
+        output reg         DE_isFPPipe_o,
         output reg         DE_wbEnable_o,
         output reg         DE_predictBranch_o,
         output reg  [BP_ADDR_BITS-1:0] DE_bhtIndex_o,
-        output reg  [31:0] DE_predictRA_o
+        output reg  [31:0] DE_predictRA_o,
+        // Second Issue Lane Interface
+        output reg         DE2_valid_o,
+        output reg  [31:0] DE2_PC_o,
+        output reg  [31:0] DE2_instr_o
 );
 
 localparam NOP = 32'b0000000_00000_00000_000_00000_0110011;
@@ -110,18 +150,110 @@ localparam NOP = 32'b0000000_00000_00000_000_00000_0110011;
  * SYSTEM  // special
  */
 
-/*------------Instruction Decompression-----------*/
-wire [31:0] D_instr;
-Decompressor decomp(FD_instr_i, D_instr);
+/*-------------------PREDECODE--------------------*/
+// Instructions arrive decompressed, with class bits from the Predecoder
+wire [31:0] D_instr1 = FD_instr_i;
+wire D_preBranch  = FD_predecode_i[0];
+wire D_preJAL     = FD_predecode_i[1];
+wire D_preJALR    = FD_predecode_i[2];
+wire D_preRdFP    = FD_predecode_i[3];
+wire D_preRs1FP   = FD_predecode_i[4];
+wire D_preRs2FP   = FD_predecode_i[5];
+wire D_preLongOp  = FD_predecode_i[6];
+wire D_preFPPipe  = FD_predecode_i[7];
+
+/*----------------MACRO-OP FUSION-----------------*/
+/*
+ * Adjacent pairs where the second instruction overwrites the result of the
+ * first are decoded as one op. The fetch unit supplies the instruction after
+ * the one in decode, and decode skips it by redirecting fetch past the pair.
+ *   FUSE[0] lui   rd, hi;      addi rd, rd, lo     -> lui rd, hi+lo
+ *   FUSE[1] auipc rd, hi;      addi rd, rd, lo     -> auipc rd, hi+lo
+ *   FUSE[2] auipc rd, hi;      jalr rd, lo(rd)     -> jal rd, hi+lo
+ *   FUSE[3] slli  rd, rs1, n;  add rd, rd, rs2     -> shNadd rd, rs1, rs2 (n = 1-3)
+ *   FUSE[4] lui   rd, hi;      lX rd, lo(rd)       -> lX rd, hi+lo(x0)
+ * The fused op retires as two instructions.
+ */
+wire [31:0] D_instr2 = FD_instr2_i;
+wire D_instr2IsRV32C = FD_instr2IsRV32C_i;
+
+wire [4:0]  D1_rdId  = D_instr1[11:7];
+wire [31:0] D1_Uimm  = {D_instr1[31:12], 12'b0};
+wire [4:0]  D2_rdId  = D_instr2[11:7];
+wire [4:0]  D2_rs1Id = D_instr2[19:15];
+wire [4:0]  D2_rs2Id = D_instr2[24:20];
+wire [31:0] D2_Iimm  = {{21{D_instr2[31]}}, D_instr2[30:20]};
+
+wire D1_isLUI   = (D_instr1[6:2] == 5'b01101);
+wire D1_isAUIPC = (D_instr1[6:2] == 5'b00101);
+wire D1_isSLLI  = (D_instr1[6:2] == 5'b00100) && (D_instr1[14:12] == 3'b001) &&
+                  (D_instr1[31:22] == 10'b0) && (D_instr1[21:20] != 2'b00);
+wire D2_isADDI  = (D_instr2[6:2] == 5'b00100) && (D_instr2[14:12] == 3'b000);
+wire D2_isADD   = (D_instr2[6:2] == 5'b01100) && (D_instr2[14:12] == 3'b000) &&
+                  (D_instr2[31:25] == 7'b0);
+wire D2_isJALR  = (D_instr2[6:2] == 5'b11001) && !D_instr2IsRV32C;
+wire D2_isLoad  = (D_instr2[6:2] == 5'b00000);
+
+// The second instruction writes the first one's rd, so only its result is seen
+wire D_fuseDep = FD_instr2Valid_i && (D1_rdId != 5'b0) && (D2_rdId == D1_rdId);
+wire D_fuseRs1 = D_fuseDep && (D2_rs1Id == D1_rdId);
+
+wire D_fuseLuiAddi   = FUSE[0] && D_fuseRs1 && D1_isLUI   && D2_isADDI;
+wire D_fuseAuipcAddi = FUSE[1] && D_fuseRs1 && D1_isAUIPC && D2_isADDI;
+wire D_fuseCall      = FUSE[2] && D_fuseRs1 && D1_isAUIPC && D2_isJALR;
+wire D_fuseSlliAdd   = FUSE[3] && D_fuseDep && D1_isSLLI  && D2_isADD &&
+        ((D2_rs1Id == D1_rdId) != (D2_rs2Id == D1_rdId));
+wire D_fuseLuiLoad   = FUSE[4] && D_fuseRs1 && D1_isLUI   && D2_isLoad;
+
+wire D_isInterrupt;
+wire D_isReplaced;      // Interrupt or exception taken in place of the instruction
+wire D_isDual;
+wire D_isFused = !FD_nop_i && !D_isReplaced && (D_fuseLuiAddi || D_fuseAuipcAddi ||
+        D_fuseCall || D_fuseSlliAdd || D_fuseLuiLoad);
+
+wire [31:0] D_fuseImm   = D1_Uimm + D2_Iimm;
+wire [4:0]  D_fuseAddRs = (D2_rs1Id == D1_rdId) ? D2_rs2Id : D2_rs1Id;
+wire [31:0] D_fusedInstr =
+        D_fuseSlliAdd ? {7'b0010000, D_fuseAddRs, D_instr1[19:15], D_instr1[21:20], 1'b0,
+                         D1_rdId, 7'b0110011} :
+        D_fuseCall    ? {20'b0, D1_rdId, 7'b1101111} :
+        D_fuseLuiLoad ? {17'b0, D_instr2[14:12], D1_rdId, 7'b0000011} :
+        /* lui/auipc + addi */ D_instr1;
+
+wire [31:0] D_instr = D_isFused ? D_fusedInstr : D_instr1;
+
+/*verilator public_flat_rw_on*/
+reg [31:0] fuseLuiAddiCount = 0;
+reg [31:0] fuseAuipcAddiCount = 0;
+reg [31:0] fuseCallCount = 0;
+reg [31:0] fuseSlliAddCount = 0;
+reg [31:0] fuseLuiLoadCount = 0;
+/*verilator public_off*/
+
+always @(posedge clk_i) begin
+        if (D_isFused && !D_stall_i && !D_flush_i) begin
+                if (D_fuseLuiAddi)
+                        fuseLuiAddiCount <= fuseLuiAddiCount + 1;
+                if (D_fuseAuipcAddi)
+                        fuseAuipcAddiCount <= fuseAuipcAddiCount + 1;
+                if (D_fuseCall)
+                        fuseCallCount <= fuseCallCount + 1;
+                if (D_fuseSlliAdd)
+                        fuseSlliAddCount <= fuseSlliAddCount + 1;
+                if (D_fuseLuiLoad)
+                        fuseLuiLoadCount <= fuseLuiLoadCount + 1;
+        end
+end
 
 /*--------------INSTRUCTION DECODING--------------*/
 // 11 RV32I OpCodes
 // bits [1:0] are always 00 for all opcodes
 wire D_isLUI      = (D_instr[6:2] == 5'b01101);
 wire D_isAUIPC    = (D_instr[6:2] == 5'b00101);
-wire D_isJAL      = (D_instr[6:2] == 5'b11011);
-wire D_isJALR     = (D_instr[6:2] == 5'b11001);
-wire D_isBranch   = (D_instr[6:2] == 5'b11000);
+// The first instruction of a fused pair is never a jump or branch
+wire D_isJAL      = D_preJAL || (D_isFused && D_fuseCall);
+wire D_isJALR     = D_preJALR;
+wire D_isBranch   = D_preBranch;
 wire D_isLoad     = (D_instr[6:3] == 4'b0000);  // instr[2]: FLW
 wire D_isStore    = (D_instr[6:3] == 4'b0100);  // instr[2]: FSW
 wire D_isALUI     = (D_instr[6:2] == 5'b00100);
@@ -142,15 +274,16 @@ wire [4:0] D_raw_rs2Id = D_instr[24:20];
 wire [4:0] D_raw_rs3Id = D_instr[31:27]; // For FMA ops
 
 // Immediate Values
-wire [31:0] D_Iimm =
+// Fused ops carry the sum of the pair's immediates
+wire [31:0] D_Iimm = D_fuseLuiLoad ? D_fuseImm :
         {{21{D_instr[31]}}, D_instr[30:20]};
 wire [31:0] D_Simm =
         {{21{D_instr[31]}}, D_instr[30:25],D_instr[11:7]};
 wire [31:0] D_Bimm =
         {{20{D_instr[31]}}, D_instr[7],D_instr[30:25],D_instr[11:8],1'b0};
-wire [31:0] D_Uimm =
+wire [31:0] D_Uimm = (D_fuseLuiAddi || D_fuseAuipcAddi) ? D_fuseImm :
         {D_instr[31], D_instr[30:12], {12{1'b0}}};
-wire [31:0] D_Jimm =
+wire [31:0] D_Jimm = D_fuseCall ? {D_fuseImm[31:1], 1'b0} :
         {{12{D_instr[31]}}, D_instr[19:12],D_instr[20],D_instr[30:21],1'b0};
 
 // Privileged Instructions
@@ -160,6 +293,7 @@ wire D_isEBREAK = D_isPrv & (D_instr[22:20] == 3'b001) & ~D_instr[25];
 wire D_isMRET   = D_isPrv &  D_instr[21] & (D_instr[30:28] == 3'b011) & ~D_instr[25];
 wire D_isSRET   = D_isPrv &  D_instr[21] & (D_instr[30:28] == 3'b001) & ~D_instr[25];
 wire D_isWFI    = D_isPrv & (D_instr[22:20] == 3'b101) & ~D_instr[25];
+wire D_isSFENCE = D_isPrv & (D_funct7 == 7'b0001001);
 
 wire D_isCSR = D_isSYS & (D_funct3[1:0] != 2'b00);
 wire [11:0] D_csrId = D_instr[31:20];
@@ -171,27 +305,28 @@ wire D_isStoreOrAMO = D_isStore | (D_isAMO & ~D_isLR);
 
 wire D_readsRs1 = !(D_isJAL || D_isLUI || D_isAUIPC);
 
-wire D_readsRs2 = (D_isStoreOrAMO || D_isBranch || D_isALUR || D_isFPU);
+wire D_readsRs2 = (D_isStoreOrAMO || D_isBranch || D_isALUR || D_isFPU || D_isSFENCE);
 
-wire D_isRV32M = D_isALUR  & D_instr[25];
+wire D_isRV32M = D_isALUR  & (D_funct7 == 7'b0000001);
 wire D_isMUL   = D_isRV32M & !D_instr[14];
 wire D_isDIV   = D_isRV32M &  D_instr[14];
 
-// rd is a FP reg if op is FLW, FMA, R-Type FPU, FCVT.S.W(U), or FMV.W.X
-wire D_rdIsFP = (D_instr[6:2] == 5'b00001)  || // FLW
-        (D_instr[6:4] == 3'b100)            || // FMA F(N)MADD / F(N)MSUB
-        (D_isFPU && ((D_instr[31] == 1'b0)  || // R-Type FPU Instr
-        (D_instr[31:28] == 4'b1101)         || // FCVT.S.W(U)
-        (D_instr[31:28] == 4'b1111)));         // FMV.W.X
+// Zba, Zbb, Zbs and Zicond use the ALU opcodes with funct7 values outside the base ISA
+wire D_isBaseALU = (D_funct7 == 7'b0000000) ||
+        ((D_funct7 == 7'b0100000) && ((D_funct3 == 3'b000) || (D_funct3 == 3'b101)));
+wire D_isBitManip = !D_isBaseALU && !D_isRV32M &&
+        (D_isALUR || (D_isALUI && (D_funct3[1:0] == 2'b01)));
+
+// Long latency ops run in the background: DIV[U], REM[U], FDIV, FSQRT
+wire D_isLongOp = D_preLongOp;
 
-// rs1 is a FP reg if op is FPU except for FCVT.S.W(U) and FMV.W.X
-wire D_rs1IsFP = D_isFPU &&
-        !((D_instr[4:2]   == 3'b100) && (
-          (D_instr[31:28] == 4'b1101) ||     // FCVT.S.W(U)
-          (D_instr[31:28] == 4'b1111)));      // FMV.W.X
+// FADD, FSUB, FMUL and FMA go down the pipelined FPU and write back from there
+wire D_isFPPipe = D_preFPPipe;
 
-// rs2 is a FP reg if op is FPU or FSW
-wire D_rs2IsFP = D_isFPU || (D_isStore && D_instr[2]);
+// Register files of rd, rs1 and rs2 (fused ops are all integer)
+wire D_rdIsFP  = D_preRdFP;
+wire D_rs1IsFP = D_preRs1FP;
+wire D_rs2IsFP = D_preRs2FP;
 
 // Floating Point Registers are encoded with id[5] == 1
 wire [5:0] D_rdId =  {D_rdIsFP , D_raw_rdId };
@@ -200,29 +335,47 @@ wire [5:0] D_rs2Id = {D_rs2IsFP, D_raw_rs2Id};
 wire [5:0] D_rs3Id = {1'b1     , D_raw_rs3Id};
 
 /*----------------BRANCH PREDICTION---------------*/
+// The BHT is read with the PC of the next instruction from fetch and the
+// counter registered along with it, so the table maps to block RAM. The counter read is carried to
+// execute for the update, so the write port never reads the table.
+(* ram_style = "block" *)
 reg [1:0] BHT[BHT_SIZE-1:0]; // Branch History Table
 
 reg [BH_BITS-1:0] branchHist;
 
+reg [BP_ADDR_BITS-1:0] D_bhtIndex;
+reg [1:0]              D_bhtCounter;
+reg [1:0]              DE_bhtCounter;
+
+wire [1:0] E_bhtCounter =
+        {E_takeBranch_i, DE_bhtCounter} == 3'b000 ? 2'b00 :
+        {E_takeBranch_i, DE_bhtCounter} == 3'b001 ? 2'b00 :
+        {E_takeBranch_i, DE_bhtCounter} == 3'b010 ? 2'b01 :
+        {E_takeBranch_i, DE_bhtCounter} == 3'b011 ? 2'b10 :
+        {E_takeBranch_i, DE_bhtCounter} == 3'b100 ? 2'b01 :
+        {E_takeBranch_i, DE_bhtCounter} == 3'b101 ? 2'b10 :
+        {E_takeBranch_i, DE_bhtCounter} == 3'b110 ? 2'b11 :
+        2'b11 ;
+
 always @(posedge clk_i) begin
         if (!E_stall_i && DE_isBranch_o) begin
                 branchHist <= {E_takeBranch_i, branchHist[BH_BITS-1:1]};
-                BHT[DE_bhtIndex_o] <= 
-                        {E_takeBranch_i, BHT[DE_bhtIndex_o]} == 3'b000 ? 2'b00 :
-                        {E_takeBranch_i, BHT[DE_bhtIndex_o]} == 3'b001 ? 2'b00 :
-                        {E_takeBranch_i, BHT[DE_bhtIndex_o]} == 3'b010 ? 2'b01 :
-                        {E_takeBranch_i, BHT[DE_bhtIndex_o]} == 3'b011 ? 2'b10 :		
-                        {E_takeBranch_i, BHT[DE_bhtIndex_o]} == 3'b100 ? 2'b01 :
-                        {E_takeBranch_i, BHT[DE_bhtIndex_o]} == 3'b101 ? 2'b10 :
-                        {E_takeBranch_i, BHT[DE_bhtIndex_o]} == 3'b110 ? 2'b11 :
-                        2'b11 ;
+                BHT[DE_bhtIndex_o] <= E_bhtCounter;
         end
 end
 
 localparam BH_SHAMT = BP_ADDR_BITS - BH_BITS;
-wire [BP_ADDR_BITS-1:0] D_bhtIndex = FD_PC_i[BP_ADDR_BITS:1] ^ {branchHist, {BH_SHAMT{1'b0}}};
+wire [BP_ADDR_BITS-1:0] F_bhtIndex = F_nextPC_i[BP_ADDR_BITS:1] ^ {branchHist, {BH_SHAMT{1'b0}}};
 
-wire D_predictBranch = BHT[D_bhtIndex][1];
+// Registered read, held with the fetch-decode register
+always @(posedge clk_i) begin
+        if (!D_stall_i) begin
+                D_bhtIndex   <= F_bhtIndex;
+                D_bhtCounter <= BHT[F_bhtIndex];
+        end
+end
+
+wire D_predictBranch = D_bhtCounter[1];
 
 /*--------------RETURN ADDRESS STACK--------------*/
 reg [31:0] RAS_0;
@@ -230,10 +383,13 @@ reg [31:0] RAS_1;
 reg [31:0] RAS_2;
 reg [31:0] RAS_3;
 
-wire [31:0] D_nextPC = FD_PC_i + (FD_isRV32C_i ? 2 : 4);
+// A fused or dual issued pair continues after its second instruction
+wire [31:0] D_PC2    = FD_PC_i + (FD_isRV32C_i ? 2 : 4);
+wire [31:0] D_nextPC = D_PC2 +
+        ((D_isFused || D_isDual) ? (D_instr2IsRV32C ? 2 : 4) : 0);
 
 always @(posedge clk_i) begin
-        if (!D_stall_i && !FD_nop_i && !D_flush_i) begin
+        if (!D_stall_i && !FD_nop_i && !D_flush_i && !D_isReplaced) begin
                 if ((D_isJAL || D_isJALR) && D_rdId == 1) begin
                         RAS_3 <= RAS_2;
                         RAS_2 <= RAS_1;
@@ -256,20 +412,79 @@ localparam US = 2'b00, SU = 2'b01, MA = 2'b11;
 reg [1:0] DD_privilege = MA;
 /*verilator public_off*/
 
-wire D_isTrap = D_isECALL;
+// Interrupts are taken on the instruction in decode, which is not executed.
+// Interrupts delegated to S mode are enabled below M mode, M mode interrupts
+// below M mode or when mstatus.MIE is set.
+wire [31:0] D_irqPending = csrMip_i & csrMie_i;
+wire [31:0] D_irqM = D_irqPending & ~csrMideleg_i;
+wire [31:0] D_irqS = D_irqPending &  csrMideleg_i;
+wire D_irqMEnable = (DD_privilege != MA) || csrMStatus_i[3];
+wire D_irqSEnable = (DD_privilege == US) || ((DD_privilege == SU) && csrMStatus_i[1]);
+wire D_irqTakeM = D_irqMEnable && (D_irqM != 0);
+wire D_irqTakeS = D_irqSEnable && (D_irqS != 0) && !D_irqTakeM;
+// Page faults are taken in decode too, so they stay in order with interrupts
+// and ECALL. A load/store page fault squashes the access in execute, refetches
+// it and is taken when it is back in decode. An instruction page fault comes
+// from fetch in place of the instruction.
+reg        DD_excPending = 1'b0;
+reg [4:0]  DD_excCause;
+reg [31:0] DD_excTval;
+
+wire D_isExc = (DD_excPending || FD_fault_i) && !FD_nop_i && !D_flush_i;
+wire [4:0]  D_excCause = DD_excPending ? DD_excCause : 5'd12;
+wire [31:0] D_excTval  = DD_excPending ? DD_excTval  : FD_faultAddr_i;
+
+assign D_isInterrupt = (D_irqTakeM || D_irqTakeS) && !FD_nop_i && !D_flush_i && !D_isExc;
+assign D_isReplaced = D_isInterrupt || D_isExc;
+
+// Highest priority pending interrupt of the mode taking it: MSI, MTI, STI, LCOFI
+wire [31:0] D_irqSel   = D_irqTakeM ? D_irqM : D_irqS;
+wire [30:0] D_irqCause = D_irqSel[3] ? 31'd3 :
+                         D_irqSel[7] ? 31'd7 :
+                         D_irqSel[5] ? 31'd5 : 31'd13;
+
+/*verilator public_flat_rw_on*/
+reg [31:0] irqTakenCount = 0;           // Interrupts taken
+reg [31:0] irqWaitCycles = 0;           // Cycles from enabled and pending to taken
+reg [31:0] irqWaitMax = 0;
+/*verilator public_off*/
+
+reg [31:0] irqWait = 0;
+wire D_irqWanted = D_irqTakeM || D_irqTakeS;
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                irqWait <= 0;
+        end else if (D_isInterrupt && !D_stall_i) begin
+                irqWait       <= 0;
+                irqTakenCount <= irqTakenCount + 1;
+                irqWaitCycles <= irqWaitCycles + irqWait;
+                if (irqWait > irqWaitMax)
+                        irqWaitMax <= irqWait;
+        end else begin
+                irqWait <= D_irqWanted ? irqWait + 1 : 0;
+        end
+end
+
+wire D_isTrap = D_isECALL | D_isReplaced;
 wire D_isPrivileged = D_isTrap | D_isMRET | D_isSRET;
 
 // Set PC, CSRs, and privilege level for traps
-wire [1:0] D_trapPrivilege =
-        (DD_privilege == US)? (csrMedeleg_i[8] ? SU : MA) :
-        (DD_privilege == SU)? (csrMedeleg_i[9] ? SU : MA) : MA;
-wire [31:0] D_trapCause = D_isECALL ? (
-        DD_privilege == US ? 32'd8 :
-        DD_privilege == SU ? 32'd9 : 32'd11) : 32'b0;
+wire [4:0] D_excCode = D_isExc ? D_excCause :
+        DD_privilege == US ? 5'd8 :
+        DD_privilege == SU ? 5'd9 : 5'd11;
+wire [1:0] D_trapPrivilege = D_isInterrupt ? (D_irqTakeS ? SU : MA) :
+        ((DD_privilege != MA) && csrMedeleg_i[D_excCode]) ? SU : MA;
+wire [31:0] D_trapCause = D_isInterrupt ? {1'b1, D_irqCause} : {27'b0, D_excCode};
+wire [31:0] D_trapTval  = D_isExc ? D_excTval : 32'b0;
+// Interrupts and exceptions return to the instruction they replaced
+wire [31:0] D_trapEpc = D_isReplaced ? FD_PC_i : D_nextPC;
 
 wire [31:0] D_MRetJumpAddr = csrMepc_i;
 wire [31:0] D_SRetJumpAddr = csrSepc_i;
-wire [31:0] D_trapJumpAddr = (D_trapPrivilege == SU) ? csrStvec_i : csrMtvec_i;
+wire [31:0] D_trapVector = (D_trapPrivilege == SU) ? csrStvec_i : csrMtvec_i;
+// Vectored mode (tvec[0]) jumps to base + 4*cause for interrupts
+wire [31:0] D_trapJumpAddr = {D_trapVector[31:2], 2'b00} +
+        ((D_isInterrupt && D_trapVector[0]) ? {D_irqCause, 2'b00} : 32'b0);
 
 wire [1:0]  D_privilegeSet = D_isTrap ?
         ((D_trapPrivilege == SU) ? SU : MA) :
@@ -286,52 +501,221 @@ wire       D_spieSet   = D_isSTrap ? csrMStatus_i[1] : csrMStatus_i[5];
 wire       D_sieSet    = D_isSTrap ? 1'b0            : csrMStatus_i[1];
 assign csrMStatusSet_o = {D_mppSet, D_mpieSet, D_mieSet, D_sppSet, D_spieSet, D_sieSet};
 
-assign csrMepcSet_o    = D_isMTrap ? D_nextPC : csrMepc_i;
+assign csrMepcSet_o    = D_isMTrap ? D_trapEpc : csrMepc_i;
 assign csrMCauseSet_o  = D_isMTrap ? D_trapCause : csrMCause_i;
-assign csrSepcSet_o    = D_isSTrap ? D_nextPC : csrSepc_i;
+assign csrSepcSet_o    = D_isSTrap ? D_trapEpc : csrSepc_i;
 assign csrSCauseSet_o  = D_isSTrap ? D_trapCause : csrSCause_i;
-assign csrTrapSetEn_o  = D_stall_i ? 1'b0 : D_isPrivileged;
+assign csrMtvalSet_o   = D_isMTrap ? D_trapTval : csrMtval_i;
+assign csrStvalSet_o   = D_isSTrap ? D_trapTval : csrStval_i;
+// Wrong path MRET/SRET/ECALL must not change the CSRs or privilege
+wire D_trapCommit = !D_stall_i && !FD_nop_i && !D_flush_i;
+assign csrTrapSetEn_o  = D_trapCommit && D_isPrivileged;
 
 always @(posedge clk_i) begin
         if (reset_i) begin
                 DD_privilege <= 2'b11;
         end
-        else if (!D_stall_i) begin
+        else if (D_trapCommit) begin
                 DD_privilege <= D_privilegeSet;
         end
 end
 
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                DD_excPending <= 1'b0;
+        end else if (E_exc_i) begin
+                DD_excPending <= 1'b1;
+                DD_excCause   <= E_excCause_i;
+                DD_excTval    <= E_excTval_i;
+        end else if (D_trapCommit && D_isExc) begin
+                DD_excPending <= 1'b0;
+        end
+end
+
+// Loads and stores translate with the privilege of decode, which only changes
+// when the trap or return leaves decode. Fetch uses the new one right away.
+assign D_privilege_o      = DD_privilege;
+assign D_fetchPrivilege_o = D_trapCommit ? D_privilegeSet : DD_privilege;
+
 /*------------Branch Prediction Result------------*/
 assign D_predictPC_o = !FD_nop_i &&
-        (D_isJAL || D_isJALR || D_isECALL || D_isMRET || D_isSRET ||
+        (D_isJAL || D_isJALR || D_isTrap || D_isMRET || D_isSRET || D_isFused || D_isDual ||
         (D_isBranch && D_predictBranch));
 
 assign D_PCprediction_o =
-        D_isJALR  ? RAS_0           :
         D_isTrap  ? D_trapJumpAddr  :
+        D_isJALR  ? RAS_0           :
         D_isMRET  ? D_MRetJumpAddr  :
         D_isSRET  ? D_SRetJumpAddr  :
+        (D_isDual || (D_isFused && !D_isJAL)) ? D_nextPC :
         (FD_PC_i + (D_isJAL ? D_Jimm : D_Bimm));
 
 
+/*-------------------SCOREBOARD-------------------*/
+wire D_readsRs3 = (D_instr[6:4] == 3'b100);     // FMA
+wire D_writesRd = !(D_isBranch || D_isStore) && (D_rdId != 6'b0);
+
+wire rs1Pending;
+wire rs2Pending;
+wire rs3Pending;
+wire rdPending;
+wire rs1Pending2;
+wire rs2Pending2;
+wire rdPending2;
+Scoreboard scoreboard(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .setEnable_i(E_longIssue_i),
+        .setId_i(DE_rdId_o),
+        .clearEnable_i(E_longDone_i),
+        .clearId_i(E_longDoneRdId_i),
+        .clear2Enable_i(E_fpPipeDone_i),
+        .clear2Id_i(E_fpPipeDoneRdId_i),
+        .rs1Id_i(D_rs1Id),
+        .rs2Id_i(D_rs2Id),
+        .rs3Id_i(D_rs3Id),
+        .rdId_i(D_rdId),
+        .rs1Id2_i({1'b0, D2_rs1Id}),
+        .rs2Id2_i({1'b0, D2_rs2Id}),
+        .rdId2_i({1'b0, D2_rdId}),
+        .rs1Pending2_o(rs1Pending2),
+        .rs2Pending2_o(rs2Pending2),
+        .rdPending2_o(rdPending2),
+        .rs1Pending_o(rs1Pending),
+        .rs2Pending_o(rs2Pending),
+        .rs3Pending_o(rs3Pending),
+        .rdPending_o(rdPending)
+);
+
 /*------------------------------------------------*/
 wire rs1Hazard = D_readsRs1 && (D_rs1Id == DE_rdId_o);
 wire rs2Hazard = D_readsRs2 && (D_rs2Id == DE_rdId_o);
+wire rs3Hazard = D_readsRs3 && (D_rs3Id == DE_rdId_o);
+wire rdHazard  = D_writesRd && (D_rdId  == DE_rdId_o);
+
+// Wait for a long latency or FP pipeline op in execute or in the scoreboard (RAW and WAW)
+/*verilator public_flat_rw_on*/
+wire longHazard = !FD_nop_i && (
+        ((DE_isLongOp_o || DE_isFPPipe_o) && (DE_rdId_o != 6'b0) &&
+                (rs1Hazard || rs2Hazard || rs3Hazard || rdHazard)) ||
+        (D_readsRs1 && rs1Pending) || (D_readsRs2 && rs2Pending) ||
+        (D_readsRs3 && rs3Pending) || (D_writesRd && rdPending));
+/*verilator public_off*/
+
+// CSRs used by the trap logic
+function csrIsTrap;
+        input [11:0] id;
+        begin
+                case (id)
+                        12'h300, 12'h310, 12'h302, 12'h312, 12'h303, 12'h304,
+                        12'h305, 12'h341, 12'h342, 12'h344, 12'h100, 12'h104,
+                        12'h105, 12'h141, 12'h142, 12'h144, 12'h343, 12'h143:
+                                csrIsTrap = 1'b1;
+                        default:
+                                csrIsTrap = 1'b0;
+                endcase
+        end
+endfunction
+
+// CSRs forwarded from the memory unit write to the CSR read port
+function csrIsForwarded;
+        input [11:0] id;
+        begin
+                csrIsForwarded = csrIsTrap(id) || (id == 12'h340) || (id == 12'h140);
+        end
+endfunction
+
+// The CSR register file forwards writes from the memory unit to the read port
+// and trap logic. A CSR write still in execute stalls a read of a CSR that is
+// not forwarded, or a trap/return if it writes a trap CSR.
+wire csrHazard = !FD_nop_i && DE_isCSR_o && (!DE_funct3_o[1] || (DE_rs1Id_o != 6'b0)) && (
+        (D_isCSR && !csrIsForwarded(D_csrId)) ||
+        (D_isPrivileged && csrIsTrap(DE_csrId_o)));
 
 assign dataHazard_o = !FD_nop_i &&
-        ((DE_isLoad_o || DE_isAMO_o || DE_isCSR_o) && (rs1Hazard || rs2Hazard)) ||
+        (DE_isMUL_o && (rs1Hazard || rs2Hazard)) ||
         (D_isLoadOrAMO && (DE_isStore_o || DE_isAMO_o)) ||
-        ((D_isCSR || D_isPrivileged) && (DE_isCSR_o && DE_rs1Id_o != 6'b0));
+        csrHazard ||
+        longHazard;
+
+// Load, AMO and CSR results used by the next instruction. These stalled for
+// a cycle before they were forwarded from the memory unit, a pair that still
+// waits on a data hazard is a load-use stall
+/*verilator public_flat_rw_on*/
+reg [31:0] loadUseFwdCount = 0;
+/*verilator public_off*/
+wire loadUse = !FD_nop_i && (DE_isLoad_o || DE_isAMO_o || DE_isCSR_o) &&
+        (DE_rdId_o != 6'b0) && (rs1Hazard || rs2Hazard || rs3Hazard);
+assign loadUseStall_o = loadUse && dataHazard_o && !longHazard;
+always @(posedge clk_i) begin
+        if (loadUse && !D_stall_i && !D_flush_i)
+                loadUseFwdCount <= loadUseFwdCount + 1;
+end
+
 assign D_isPrivileged_o = D_isPrivileged;
+assign longHazard_o = longHazard;
+assign csrHazard_o = csrHazard;
+
+/*----------------SECOND ISSUE LANE---------------*/
+/*
+ * The instruction after the one in decode is issued down the simple lane
+ * alongside it when it is a base integer ALU op (LUI, AUIPC, OP-IMM, OP) that
+ * does not depend on it. The first instruction can be anything but a jump,
+ * a branch predicted taken, SYSTEM or FENCE. Fetch is redirected past the
+ * pair like a fused op. A second instruction that is not independent waits
+ * and is issued alone in the next cycle.
+ */
+wire D2_isLUI   = (D_instr2[6:2] == 5'b01101);
+wire D2_isAUIPC = (D_instr2[6:2] == 5'b00101);
+wire D2_isALUI  = (D_instr2[6:2] == 5'b00100);
+wire D2_isALUR  = (D_instr2[6:2] == 5'b01100);
+wire D2_isBaseALU = (D_instr2[31:25] == 7'b0) || ((D_instr2[31:25] == 7'b0100000) &&
+        ((D_instr2[14:12] == 3'b000) || (D_instr2[14:12] == 3'b101)));
+wire D2_isSimple = D2_isLUI || D2_isAUIPC || (D2_isALUR && D2_isBaseALU) ||
+        (D2_isALUI && ((D_instr2[13:12] != 2'b01) || D2_isBaseALU));
+wire D2_readsRs1 = D2_isALUI || D2_isALUR;
+wire D2_readsRs2 = D2_isALUR;
+
+wire D_dualFirstOk = !(D_isJAL || D_isJALR || D_isSYS || D_isFENCE ||
+        (D_isBranch && D_predictBranch));
+
+// RAW and WAW on the first instruction
+wire D_dualDep = D_writesRd && (({1'b0, D2_rdId} == D_rdId) ||
+        (D2_readsRs1 && ({1'b0, D2_rs1Id} == D_rdId)) ||
+        (D2_readsRs2 && ({1'b0, D2_rs2Id} == D_rdId)));
 
-wire D_isNOP = E_flush_i | FD_nop_i | D_isWFI;
+// MUL and long latency results in execute, or pending in the scoreboard
+wire D2_rs1Hazard = D2_readsRs1 && ({1'b0, D2_rs1Id} == DE_rdId_o);
+wire D2_rs2Hazard = D2_readsRs2 && ({1'b0, D2_rs2Id} == DE_rdId_o);
+wire D2_rdHazard  = ({1'b0, D2_rdId} == DE_rdId_o);
+wire D_dualHazard =
+        ((DE_isMUL_o || DE_isLongOp_o) && (DE_rdId_o != 6'b0) &&
+                (D2_rs1Hazard || D2_rs2Hazard || D2_rdHazard)) ||
+        (D2_readsRs1 && rs1Pending2) || (D2_readsRs2 && rs2Pending2) || rdPending2;
+
+assign D_isDual = DUAL && FD_instr2Valid_i && !FD_nop_i && !D_isReplaced &&
+        !D_isFused && D2_isSimple && D_dualFirstOk && !D_dualDep && !D_dualHazard;
+
+/*verilator public_flat_rw_on*/
+reg [31:0] dualIssueCount = 0;
+/*verilator public_off*/
+
+/*------------------------------------------------*/
+wire D_isNOP = E_flush_i | FD_nop_i | D_isWFI | D_isReplaced;
 always @(posedge clk_i) begin
         if (!D_stall_i) begin
                 DE_PC_o <= FD_PC_i;
                 DE_instr_o <= D_isNOP ? NOP : D_instr;
                 DE_isRV32C_o <= FD_isRV32C_i;
+                DE_isFused_o <= D_isFused;
                 DE_nop_o <= D_isNOP;
 
+                DE2_valid_o <= D_isDual && !D_isNOP;
+                DE2_PC_o    <= D_PC2;
+                DE2_instr_o <= D_instr2;
+                if (D_isDual && !D_isNOP)
+                        dualIssueCount <= dualIssueCount + 1;
+
                 DE_isLUI_o    <= D_isLUI;
                 DE_isAUIPC_o  <= D_isAUIPC;
                 DE_isJAL_o    <= D_isJAL;
@@ -364,19 +748,25 @@ always @(posedge clk_i) begin
                 DE_Uimm_o <= D_Uimm;
 
                 DE_isRV32M_o <= D_isRV32M;
+                DE_isBitManip_o <= D_isBitManip;
                 DE_isMUL_o   <= D_isMUL;
                 DE_isDIV_o   <= D_isDIV;
+                DE_isLongOp_o <= D_isLongOp;
+                DE_isFPPipe_o <= D_isFPPipe;
 
                 DE_wbEnable_o <= ~(D_isBranch | D_isStore);
 
                 DE_predictBranch_o <= D_predictBranch;
                 DE_bhtIndex_o <= D_bhtIndex;
+                DE_bhtCounter <= D_bhtCounter;
                 DE_predictRA_o <= RAS_0;
         end
 
-        if (E_flush_i || FD_nop_i) begin
+        if (E_flush_i || ((FD_nop_i || D_isReplaced) && !D_stall_i)) begin
                 DE_instr_o    <= NOP;
                 DE_nop_o      <= 1'b1;
+                DE_isFused_o  <= 1'b0;
+                DE2_valid_o   <= 1'b0;
                 DE_isLUI_o    <= 1'b0;
                 DE_isAUIPC_o  <= 1'b0;
                 DE_isJAL_o    <= 1'b0;
@@ -393,8 +783,11 @@ always @(posedge clk_i) begin
                 DE_isAMO_o    <= 1'b0;
                 DE_isFPU_o    <= 1'b0;
                 DE_isRV32M_o  <= 1'b0;
+                DE_isBitManip_o <= 1'b0;
                 DE_isMUL_o    <= 1'b0;
                 DE_isDIV_o    <= 1'b0;
+                DE_isLongOp_o <= 1'b0;
+                DE_isFPPipe_o <= 1'b0;
                 DE_wbEnable_o <= 1'b0;
         end
 end
@@ -19,29 +19,75 @@ module ExecuteUnit (
         output reg         EF_correctPC_o,
         output reg  [31:0] EF_PCcorrection_o,
         output wire        aluBusy_o,
+        output wire        E_memStall_o,
+        // Long Latency Ops (DIV, FDIV, FSQRT)
+        output wire        E_longIssue_o,
+        output wire        E_longDone_o,
+        output wire [5:0]  E_longDoneRdId_o,
+        // Instruction Cache
+        output wire        E_fenceI_o,
+        // Address Translation
+        output wire        E_sfence_o,
+        output wire [31:0] E_sfenceAddr_o,
+        output wire [8:0]  E_sfenceAsid_o,
+        output wire        E_sfenceAllAddr_o,
+        output wire        E_sfenceAllAsid_o,
+        output wire        E_satpWrite_o,
+        output wire        E_exc_o,         // Load/store page fault, taken in decode
+        output wire [4:0]  E_excCause_o,
+        output wire [31:0] E_excTval_o,
+        // Pipelined FPU (FADD, FSUB, FMUL, FMA)
+        output wire        E_fpPipeDone_o,
+        output wire [5:0]  E_fpPipeDoneRdId_o,
         // Register File Interface
-        output wire [5:0]  rs1Id_o,
-        output wire [5:0]  rs2Id_o,
-        output wire [5:0]  rs3Id_o,
-        input  wire [63:0] rs1Data_i,
-        input  wire [63:0] rs2Data_i,
-        input  wire [63:0] rs3Data_i,
+        output wire [4:0]  rs1Id_o,
+        output wire [4:0]  rs2Id_o,
+        output wire [4:0]  rs3Id_o,
+        input  wire [31:0] rs1Data_i,
+        input  wire [31:0] rs2Data_i,
+        input  wire [63:0] fpRs1Data_i,
+        input  wire [63:0] fpRs2Data_i,
+        input  wire [63:0] fpRs3Data_i,
+        output wire        fpWrEnable_o,
+        output wire [4:0]  fpWrId_o,
+        output wire [63:0] fpWrData_o,
         // CSR Interface
         output wire [11:0] csrRAddr_o,
         input  wire [31:0] csrRData_i,
         output wire [4:0]  csrFFlagsSet_o,
         input  wire [2:0]  csrFRM_i,
         // Memory Interface
-        output wire [31:0] DMemRAddr_o,
+        output wire [31:0] DMemRAddr_o,     // Virtual address
+        output wire        DMemREnable_o,
+        output wire        DMemRDouble_o,
+        output wire        DMemAccess_o,
+        output wire        DMemRead_o,
+        output wire        DMemWrite_o,
+        input  wire [31:0] DMemPAddr_i,
+        input  wire        DMemXlateWait_i,
+        input  wire        DMemPageFault_i,
         input  wire [63:0] DMemRData_i,
+        input  wire        DMemRValid_i,
+        input  wire        DMemSbAlmostFull_i,
+        input  wire        DMemSbEmpty_i,
+        output wire        IO_memReq_o,     // IO access waiting for the IO port
+        input  wire        IO_memGrant_i,
         // Register Forwarding
         input  wire        MW_wbEnable_i,
         input  wire [5:0]  MW_rdId_i,
         input  wire [63:0] MW_wbData_i,
+        input  wire [63:0] M_fwdData_i,
+        input  wire        EM2_wbEnable_i,
+        input  wire [4:0]  EM2_rdId_i,
+        input  wire [31:0] EM2_result_i,
+        input  wire        MW2_wbEnable_i,
+        input  wire [4:0]  MW2_rdId_i,
+        input  wire [31:0] MW2_wbData_i,
         // Decode Unit Interface
         input  wire [31:0] DE_PC_i,
         input  wire [31:0] DE_instr_i,
         input  wire        DE_isRV32C_i,
+        input  wire        DE_isFused_i,
         input  wire        DE_nop_i,
         input  wire        DE_isLUI_i,
         input  wire        DE_isAUIPC_i,
@@ -71,8 +117,11 @@ module ExecuteUnit (
         input  wire [31:0] DE_Bimm_i,
         input  wire [31:0] DE_Uimm_i,
         input  wire        DE_isRV32M_i,
+        input  wire        DE_isBitManip_i,
         input  wire        DE_isMUL_i,
         input  wire        DE_isDIV_i,
+        input  wire        DE_isLongOp_i,
+        input  wire        DE_isFPPipe_i,
         input  wire        DE_wbEnable_i,
         input  wire        DE_predictBranch_i,
         input  wire [31:0] DE_predictRA_i,
@@ -80,11 +129,16 @@ module ExecuteUnit (
         output reg  [31:0] EM_PC_o,
         output reg  [31:0] EM_instr_o,
         output reg         EM_nop_o,
+        output reg         EM_isFused_o,
         output reg         EM_isLoad_o,
         output reg         EM_isStore_o,
         output reg         EM_isCSR_o,
         output reg         EM_isCSRWrite_o,
         output reg         EM_isAMO_o,
+        output reg         EM_isMUL_o,
+        output reg         EM_mulHigh_o,
+        output reg  signed [32:0] EM_mulA_o,
+        output reg  signed [32:0] EM_mulB_o,
         output reg  [5:0]  EM_rdId_o,
         output reg  [5:0]  EM_rs1Id_o,
         output reg  [5:0]  EM_rs2Id_o,
@@ -101,7 +155,18 @@ module ExecuteUnit (
 localparam NOP = 32'b0000000_00000_00000_000_00000_0110011;
 
 /*---------------REGISTER FORWARDING--------------*/
-// Forward from End of Execute Unit
+// Integer and FP sources have separate networks: the integer one is 32 bits
+// wide and the FP one never sees the second issue lane. Register ids carry the
+// file in bit 5, so a match in one network never selects the other.
+
+// The second issue lane holds the younger instruction of each pair, so it is
+// forwarded ahead of the first lane at the same stage
+wire E2fwd_rs1 = EM2_wbEnable_i && ({1'b0, EM2_rdId_i} == DE_rs1Id_i);
+wire E2fwd_rs2 = EM2_wbEnable_i && ({1'b0, EM2_rdId_i} == DE_rs2Id_i);
+wire W2fwd_rs1 = MW2_wbEnable_i && ({1'b0, MW2_rdId_i} == DE_rs1Id_i);
+wire W2fwd_rs2 = MW2_wbEnable_i && ({1'b0, MW2_rdId_i} == DE_rs2Id_i);
+
+// Forward from the Memory Unit (ALU result, or aligned load/AMO/CSR data)
 wire EMfwd_rs1 = EM_wbEnable_o && (EM_rdId_o == DE_rs1Id_i);
 wire EMfwd_rs2 = EM_wbEnable_o && (EM_rdId_o == DE_rs2Id_i);
 wire EMfwd_rs3 = EM_wbEnable_o && (EM_rdId_o == DE_rs3Id_i);
@@ -111,26 +176,53 @@ wire EWfwd_rs1 = MW_wbEnable_i && (MW_rdId_i == DE_rs1Id_i);
 wire EWfwd_rs2 = MW_wbEnable_i && (MW_rdId_i == DE_rs2Id_i);
 wire EWfwd_rs3 = MW_wbEnable_i && (MW_rdId_i == DE_rs3Id_i);
 
-assign rs1Id_o = DE_rs1Id_i;
-assign rs2Id_o = DE_rs2Id_i;
-assign rs3Id_o = DE_rs3Id_i;
-
-wire [63:0] E_rs1 = EMfwd_rs1 ? EM_Eresult_o :
-        EWfwd_rs1 ? MW_wbData_i : rs1Data_i;
-
-wire [63:0] E_rs2 = EMfwd_rs2 ? EM_Eresult_o :
-        EWfwd_rs2 ? MW_wbData_i : rs2Data_i;
-
-wire [63:0] E_rs3 = EMfwd_rs3 ? EM_Eresult_o :
-        EWfwd_rs3 ? MW_wbData_i : rs3Data_i;
+// Forward from the FP pipeline result register
+wire        E_pipeValid;
+wire [5:0]  E_pipeRdId;
+wire [63:0] E_pipeResult;
+wire EPfwd_rs1 = E_pipeValid && (E_pipeRdId == DE_rs1Id_i);
+wire EPfwd_rs2 = E_pipeValid && (E_pipeRdId == DE_rs2Id_i);
+wire EPfwd_rs3 = E_pipeValid && (E_pipeRdId == DE_rs3Id_i);
+
+assign rs1Id_o = DE_rs1Id_i[4:0];
+assign rs2Id_o = DE_rs2Id_i[4:0];
+assign rs3Id_o = DE_rs3Id_i[4:0];
+
+// Integer
+wire [31:0] E_rs1i = E2fwd_rs1 ? EM2_result_i :
+        EMfwd_rs1 ? M_fwdData_i[31:0] :
+        W2fwd_rs1 ? MW2_wbData_i :
+        EWfwd_rs1 ? MW_wbData_i[31:0] : rs1Data_i;
+
+wire [31:0] E_rs2i = E2fwd_rs2 ? EM2_result_i :
+        EMfwd_rs2 ? M_fwdData_i[31:0] :
+        W2fwd_rs2 ? MW2_wbData_i :
+        EWfwd_rs2 ? MW_wbData_i[31:0] : rs2Data_i;
+
+// FP
+wire [63:0] E_rs1f = EMfwd_rs1 ? M_fwdData_i :
+        EWfwd_rs1 ? MW_wbData_i :
+        EPfwd_rs1 ? E_pipeResult : fpRs1Data_i;
+
+wire [63:0] E_rs2f = EMfwd_rs2 ? M_fwdData_i :
+        EWfwd_rs2 ? MW_wbData_i :
+        EPfwd_rs2 ? E_pipeResult : fpRs2Data_i;
+
+wire [63:0] E_rs3 = EMfwd_rs3 ? M_fwdData_i :
+        EWfwd_rs3 ? MW_wbData_i :
+        EPfwd_rs3 ? E_pipeResult : fpRs3Data_i;
+
+// FPU operands and store data, integer sources NaN-boxed
+wire [63:0] E_rs1 = DE_rs1Id_i[5] ? E_rs1f : {32'hFFFFFFFF, E_rs1i};
+wire [63:0] E_rs2 = DE_rs2Id_i[5] ? E_rs2f : {32'hFFFFFFFF, E_rs2i};
 
 /*---------------ADD/SUBTRACT/SHIFT---------------*/
 wire [31:0] E_aluIn1 =
         DE_isAMO_i ? DMemRData_i[31:0] :
-        DE_isCSR_i ? csrRData_i  : E_rs1[31:0];
+        DE_isCSR_i ? csrRData_i  : E_rs1i;
 wire [31:0] E_aluIn2 =
-        (DE_isALUR_i | DE_isBranch_i | DE_isAMO_i) ? E_rs2[31:0] :
-        (DE_isCSR_i ? (DE_funct3_i[2] ? {26'b0, DE_rs1Id_i} : E_rs1[31:0]) : DE_Iimm_i);
+        (DE_isALUR_i | DE_isBranch_i | DE_isAMO_i) ? E_rs2i :
+        (DE_isCSR_i ? (DE_funct3_i[2] ? {26'b0, DE_rs1Id_i} : E_rs1i) : DE_Iimm_i);
 
 // Add Subtract
 wire E_isMinus = DE_funct7_i[5] & DE_isALUR_i;
@@ -157,11 +249,15 @@ function [31:0] flip32;
 endfunction
 
 // Bit Shifts
-wire E_arithShift = DE_funct7_i[5];
+// The upper word is shifted in from the left: sign bits for SRA, the input
+// itself for rotates (ROR/RORI, ROL through the flip)
+wire E_arithShift = DE_funct7_i[5] & !DE_isBitManip_i;
+wire E_isRotate = DE_isBitManip_i & (DE_funct7_i == 7'b0110000);
 wire [31:0] E_shifterIn = 
         (DE_funct3_i == 3'b001) ? flip32(E_aluIn1) : E_aluIn1;
-wire [32:0] E_shifter =
-        $signed({E_arithShift & E_aluIn1[31], E_shifterIn}) >>> E_aluIn2[4:0];
+wire [31:0] E_shifterHi =
+        E_isRotate ? E_shifterIn : {32{E_arithShift & E_aluIn1[31]}};
+wire [63:0] E_shifter = {E_shifterHi, E_shifterIn} >> E_aluIn2[4:0];
 wire [31:0] E_leftShift = flip32(E_shifter[31:0]);
 
 wire [31:0] E_aluOutBase = 
@@ -174,62 +270,108 @@ wire [31:0] E_aluOutBase =
         (DE_funct3_is_i[6] ? E_aluOR                                    : 32'b0) |
         (DE_funct3_is_i[7] ? E_aluAND                                   : 32'b0) ;
 
+/*----------------BIT MANIPULATION----------------*/
+// Zba, Zbb, Zbs and Zicond. Rotates and BEXT use the shifter above
+function [5:0] popcount32;
+        input [31:0] x;
+        integer i;
+        begin
+                popcount32 = 6'b0;
+                for (i = 0; i < 32; i = i + 1)
+                        popcount32 = popcount32 + x[i];
+        end
+endfunction
+
+// CTZ counts the leading zeros of the flipped input
+wire [31:0] E_clzIn = DE_Iimm_i[0] ? flip32(E_aluIn1) : E_aluIn1;
+wire [4:0]  E_clzOut;
+CLZ #(.W_IN(32)) clz(E_clzIn, E_clzOut);
+wire [5:0]  E_clz = (E_clzIn == 32'b0) ? 6'd32 : {1'b0, E_clzOut};
+
+// CLZ, CTZ, CPOP, SEXT.B, SEXT.H (selected by the rs2 field)
+wire [31:0] E_unaryOut =
+        (DE_Iimm_i[2:0] == 3'b000) ? {26'b0, E_clz} :
+        (DE_Iimm_i[2:0] == 3'b001) ? {26'b0, E_clz} :
+        (DE_Iimm_i[2:0] == 3'b010) ? {26'b0, popcount32(E_aluIn1)} :
+        (DE_Iimm_i[2:0] == 3'b100) ? {{24{E_aluIn1[7]}}, E_aluIn1[7:0]} :
+                                     {{16{E_aluIn1[15]}}, E_aluIn1[15:0]};
+
+wire [31:0] E_bitMask = 32'b1 << E_aluIn2[4:0];
+wire [31:0] E_shAdd = (E_aluIn1 << DE_funct3_i[2:1]) + E_aluIn2;
+wire [31:0] E_orcb = {{8{|E_aluIn1[31:24]}}, {8{|E_aluIn1[23:16]}},
+                      {8{|E_aluIn1[15:8]}},  {8{|E_aluIn1[7:0]}}};
+wire [31:0] E_rev8 = {E_aluIn1[7:0], E_aluIn1[15:8], E_aluIn1[23:16], E_aluIn1[31:24]};
+wire        E_rs2Zero = (E_aluIn2 == 32'b0);
+
+reg [31:0] E_bitOut;
+always @(*) begin
+        case ({DE_funct7_i, DE_funct3_i})
+                {7'b0010000, 3'b010},                                   // sh1add
+                {7'b0010000, 3'b100},                                   // sh2add
+                {7'b0010000, 3'b110}: E_bitOut = E_shAdd;               // sh3add
+                {7'b0100000, 3'b111}: E_bitOut = E_aluIn1 & ~E_aluIn2;  // andn
+                {7'b0100000, 3'b110}: E_bitOut = E_aluIn1 | ~E_aluIn2;  // orn
+                {7'b0100000, 3'b100}: E_bitOut = ~E_aluXOR;             // xnor
+                {7'b0000101, 3'b100}: E_bitOut =  E_LT  ? E_aluIn1 : E_aluIn2; // min
+                {7'b0000101, 3'b101}: E_bitOut =  E_LTU ? E_aluIn1 : E_aluIn2; // minu
+                {7'b0000101, 3'b110}: E_bitOut = !E_LT  ? E_aluIn1 : E_aluIn2; // max
+                {7'b0000101, 3'b111}: E_bitOut = !E_LTU ? E_aluIn1 : E_aluIn2; // maxu
+                {7'b0000100, 3'b100}: E_bitOut = {16'b0, E_aluIn1[15:0]};     // zext.h
+                {7'b0110000, 3'b001}: E_bitOut = DE_isALUI_i ? E_unaryOut : E_leftShift; // rol
+                {7'b0110000, 3'b101}: E_bitOut = E_shifter[31:0];       // ror, rori
+                {7'b0100100, 3'b001}: E_bitOut = E_aluIn1 & ~E_bitMask; // bclr, bclri
+                {7'b0100100, 3'b101}: E_bitOut = {31'b0, E_shifter[0]}; // bext, bexti
+                {7'b0010100, 3'b001}: E_bitOut = E_aluIn1 |  E_bitMask; // bset, bseti
+                {7'b0010100, 3'b101}: E_bitOut = E_orcb;                // orc.b
+                {7'b0110100, 3'b001}: E_bitOut = E_aluIn1 ^  E_bitMask; // binv, binvi
+                {7'b0110100, 3'b101}: E_bitOut = E_rev8;                // rev8
+                {7'b0000111, 3'b101}: E_bitOut = E_rs2Zero ? 32'b0 : E_aluIn1; // czero.eqz
+                {7'b0000111, 3'b111}: E_bitOut = E_rs2Zero ? E_aluIn1 : 32'b0; // czero.nez
+                default:              E_bitOut = 32'b0;
+        endcase
+end
+
 /*--------------------MULTIPLY--------------------*/
+// Operands are registered into EM and multiplied in the memory unit
 wire E_isMULH   = DE_funct3_is_i[1];
 wire E_isMULHSU = DE_funct3_is_i[2];
 
-wire E_mulSign1 = E_rs1[31] & E_isMULH;
-wire E_mulSign2 = E_rs2[31] & (E_isMULH | E_isMULHSU);
+wire E_mulSign1 = E_rs1i[31] & E_isMULH;
+wire E_mulSign2 = E_rs2i[31] & (E_isMULH | E_isMULHSU);
 
-wire signed [32:0] E_mulSigned1 = {E_mulSign1, E_rs1[31:0]};
-wire signed [32:0] E_mulSigned2 = {E_mulSign2, E_rs2[31:0]};
-wire signed [63:0] E_multiply   = E_mulSigned1 * E_mulSigned2;
+wire signed [32:0] E_mulSigned1 = {E_mulSign1, E_rs1i};
+wire signed [32:0] E_mulSigned2 = {E_mulSign2, E_rs2i};
 
 /*---------------------DIVIDE---------------------*/
-reg [31:0] EE_dividend;
-reg [62:0] EE_divisor;
-reg [31:0] EE_quotient;
-reg [31:0] EE_quotientMsk;
-
-reg EE_divSign;
-reg EE_divBusy     = 1'b0;
-reg EE_divFinished = 1'b0;
-
-wire E_divstepDo = (EE_divisor <= {31'b0, EE_dividend});
-
+wire        E_divBusy;
+wire        E_divReady;
+wire [31:0] E_divOut;
+wire        E_divOccupied = E_divBusy | E_divReady;
+wire        E_injectDiv;
+wire        E_injectFpu;
+wire        E_divIssue = DE_isDIV_i & !E_divOccupied & !E_stall_i;
+
+reg  [5:0]  EE_divRdId;
+reg  [31:0] EE_divInstr;
 always @(posedge clk_i) begin
-        if (!EE_divBusy) begin
-                if (DE_isDIV_i & !dataHazard_i & !EE_divFinished) begin
-                        EE_quotientMsk <= 1 << 31;
-                        EE_divBusy <= 1'b1;
-                end
-                EE_dividend <= ~DE_funct3_i[0] & E_rs1[31] ? -E_rs1[31:0] : E_rs1[31:0];
-                EE_divisor <=
-                        {(~DE_funct3_i[0] & E_rs2[31] ? -E_rs2[31:0] : E_rs2[31:0]), 31'b0};
-                EE_quotient <= 0;
-                EE_divSign <= ~DE_funct3_i[0] & (DE_funct3_i[1] ? E_rs1[31] :
-                        (E_rs1[31] != E_rs2[31]) & |E_rs2[31:0]);
-        end else begin
-                EE_dividend <= E_divstepDo ? EE_dividend - EE_divisor[31:0] :
-                                             EE_dividend;
-                EE_divisor <= EE_divisor >> 1;
-                EE_quotient <= E_divstepDo ? EE_quotient | EE_quotientMsk :
-                                             EE_quotient;
-                EE_quotientMsk <=EE_quotientMsk >> 1;
-                EE_divBusy <= EE_divBusy & !EE_quotientMsk[0];
+        if (E_divIssue) begin
+                EE_divRdId <= DE_rdId_i;
+                EE_divInstr <= DE_instr_i;
         end
-        EE_divFinished <= EE_quotientMsk[0];
 end
 
-wire [2:0] E_divsel = {DE_isDIV_i, DE_funct3_i[1], EE_divSign};
-
-wire [31:0] E_aluOutM = 
-        (  DE_funct3_is_i[0]    ?  E_multiply[31:0]  : 32'b0) | // MUL
-        ( |DE_funct3_is_i[3:1]  ?  E_multiply[63:32] : 32'b0) | // MULH[[S]U]
-        (  E_divsel == 3'b100 ?  EE_quotient       : 32'b0) | // DIV
-        (  E_divsel == 3'b101 ? -EE_quotient       : 32'b0) | // DIV Negative
-        (  E_divsel == 3'b110 ?  EE_dividend       : 32'b0) | // REM
-        (  E_divsel == 3'b111 ? -EE_dividend       : 32'b0) ; // REM Negative
+IDIV idiv(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .divEnable_i(E_divIssue),
+        .resultAck_i(E_injectDiv),
+        .funct3_i(DE_funct3_i),
+        .rs1_i(E_rs1i),
+        .rs2_i(E_rs2i),
+        .busy_o(E_divBusy),
+        .ready_o(E_divReady),
+        .divOut_o(E_divOut)
+);
 
 /*-----------------------CSR----------------------*/
 assign csrRAddr_o = DE_isCSR_i ? DE_csrId_i : 12'bZ;
@@ -243,10 +385,30 @@ wire [31:0] E_csrOut =
 /*-----------Atomic Memory Instructions-----------*/
 // Memory access address
 wire [31:0] E_addr =
-        DE_isAMO_i   ? E_rs1[31:0]             :
-        DE_isStore_i ? E_rs1[31:0] + DE_Simm_i : E_rs1[31:0] + DE_Iimm_i;
+        DE_isAMO_i   ? E_rs1i             :
+        DE_isStore_i ? E_rs1i + DE_Simm_i : E_rs1i + DE_Iimm_i;
 assign DMemRAddr_o = E_addr;
 
+// The MMU translates E_addr. AMOs need read and write permission, except LR
+// (read) and SC (write). Their faults are store faults, except LR.
+wire E_isLR = DE_isAMO_i & (DE_funct7_i[6:2] == 5'h02);
+wire E_isSC = DE_isAMO_i & (DE_funct7_i[6:2] == 5'h03);
+wire E_memAccess = (DE_isLoad_i | DE_isStore_i | DE_isAMO_i) & !DE_nop_i;
+assign DMemAccess_o = E_memAccess;
+assign DMemRead_o   = DE_isLoad_i | (DE_isAMO_i & !E_isSC);
+assign DMemWrite_o  = DE_isStore_i | (DE_isAMO_i & !E_isLR);
+wire [31:0] E_paddr = DMemPAddr_i;
+wire E_pageFault = E_memAccess & DMemPageFault_i;
+
+// Loads and AMOs read the data cache. IO is read in the memory unit
+assign DMemREnable_o = (DE_isLoad_i | DE_isAMO_i) & !DE_nop_i & !E_paddr[22] &
+        !DMemXlateWait_i & !DMemPageFault_i;
+assign DMemRDouble_o = DE_isLoad_i & (DE_funct3_i == 3'b011);  // FLD
+
+// IO is accessed in the memory unit, once the IO port is granted to this hart
+wire E_ioAccess = E_memAccess & E_paddr[22] & !DMemXlateWait_i & !DMemPageFault_i;
+assign IO_memReq_o = E_ioAccess;
+
 wire [31:0] E_amoOut = 
         (DE_funct7_i[6:2] == 5'h00 ?                      E_aluPlus : 32'b0) | // amoadd.w
         (DE_funct7_i[6:2] == 5'h01 ?                      E_aluIn2  : 32'b0) | // amoswap.w
@@ -258,12 +420,17 @@ wire [31:0] E_amoOut =
         (DE_funct7_i[6:2] == 5'h18 ? ( E_LTU ? E_aluIn1 : E_aluIn2) : 32'b0) | // amominu.w
         (DE_funct7_i[6:2] == 5'h1C ? (!E_LTU ? E_aluIn1 : E_aluIn2) : 32'b0) ; // amomaxu.w
 
-wire [31:0] E_aluOut_32 = DE_isRV32M_i ? E_aluOutM : 
-                          DE_isCSR_i   ? E_csrOut  :
-                          DE_isAMO_i   ? E_amoOut  : E_aluOutBase;
+wire [31:0] E_aluOut_32 = DE_isCSR_i      ? E_csrOut  :
+                          DE_isAMO_i      ? E_amoOut  :
+                          DE_isBitManip_i ? E_bitOut  : E_aluOutBase;
 
 /*----------------------FPU-----------------------*/
 wire E_fpuBusy;
+wire        E_fpuLongIssue;
+wire        E_fpuLongReady;
+wire [5:0]  E_fpuLongRdId;
+wire [31:0] E_fpuLongInstr;
+wire [63:0] E_fpuLongOut;
 wire [2:0] E_fpuRound = (&DE_funct3_i) ? csrFRM_i : DE_funct3_i;
 wire [63:0] E_fpuOut;
 FPU fpu(
@@ -273,16 +440,81 @@ FPU fpu(
         .instr_i(DE_instr_i),
         .rs1_i(E_rs1),
         .rs2_i(E_rs2),
-        .rs3_i(E_rs3),
         .rm_i(E_fpuRound),
         .fflags_o(csrFFlagsSet_o),
         .busy_o(E_fpuBusy),
-        .fpuOut_o(E_fpuOut)
+        .fpuOut_o(E_fpuOut),
+        .stall_i(E_stall_i),
+        .rdId_i(DE_rdId_i),
+        .longAck_i(E_injectFpu),
+        .longIssue_o(E_fpuLongIssue),
+        .longReady_o(E_fpuLongReady),
+        .longRdId_o(E_fpuLongRdId),
+        .longInstr_o(E_fpuLongInstr),
+        .longOut_o(E_fpuLongOut)
+);
+
+// FADD, FSUB, FMUL and FMA. Results skip the memory and writeback stages and
+// are written by the second FP port of the register file.
+wire E_fpPipeIssue = DE_isFPPipe_i & !E_stall_i;
+FPUPipe fpuPipe(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .issue_i(E_fpPipeIssue),
+        .instr_i(DE_instr_i),
+        .rdId_i(DE_rdId_i),
+        .rs1_i(E_rs1),
+        .rs2_i(E_rs2),
+        .rs3_i(E_rs3),
+        .rm_i(E_fpuRound),
+        .finishing_o(E_fpPipeDone_o),
+        .finishingRdId_o(E_fpPipeDoneRdId_o),
+        .resultValid_o(E_pipeValid),
+        .resultRdId_o(E_pipeRdId),
+        .result_o(E_pipeResult)
 );
 
+assign fpWrEnable_o = E_pipeValid;
+assign fpWrId_o = E_pipeRdId[4:0];
+assign fpWrData_o = E_pipeResult;
+
 wire [63:0] E_aluOut = DE_isFPU_i ? E_fpuOut : {32'hFFFFFFFF, E_aluOut_32};
 
-assign aluBusy_o = EE_divBusy | (DE_isDIV_i & !EE_divFinished) | E_fpuBusy;
+/*--------------LONG LATENCY WRITEBACK------------*/
+// DIV, FDIV and FSQRT leave the execute stage without writing back and
+// complete in the background. The scoreboard in the decode unit stalls any
+// instruction that depends on their results. A finished result is written
+// into the EM register in place of an empty slot, or stalls execute for a cycle.
+// FP pipeline ops also mark their destination pending until their last stage.
+assign E_longIssue_o = E_divIssue | E_fpuLongIssue | E_fpPipeIssue;
+
+// Integer divide has priority
+assign      E_injectDiv = E_divReady;
+assign      E_injectFpu = !E_divReady & E_fpuLongReady;
+wire        E_inject    = E_injectDiv | E_injectFpu;
+wire [5:0]  E_injectRdId  = E_injectDiv ? EE_divRdId  : E_fpuLongRdId;
+wire [31:0] E_injectInstr = E_injectDiv ? EE_divInstr : E_fpuLongInstr;
+wire [63:0] E_injectData  = E_injectDiv ? {32'hFFFFFFFF, E_divOut} : E_fpuLongOut;
+
+assign E_longDone_o = E_inject;
+assign E_longDoneRdId_o = E_injectRdId;
+
+// Stall if the unit is still occupied, or to make room for a result
+wire E_structStall = (DE_isDIV_i & E_divOccupied) | E_fpuBusy;
+wire E_injectStall = E_inject & !DE_nop_i & !DE_isLongOp_i;
+
+// Wait for a load miss, room in the store buffer, or for FENCE and AMOs to
+// drain it. An AMO write is then always at the head of the store buffer.
+// Also wait for a page walk on a D-TLB miss, and for the IO port.
+wire E_memStall =
+        (E_memAccess & DMemXlateWait_i) |
+        (E_ioAccess & !IO_memGrant_i) |
+        (DMemREnable_o & !DMemRValid_i) |
+        (DE_isStore_i & !DE_nop_i & DMemSbAlmostFull_i) |
+        ((DE_isFENCE_i | DE_isAMO_i) & !DE_nop_i & !DMemSbEmpty_i);
+
+assign aluBusy_o = E_structStall | E_injectStall | E_memStall;
+assign E_memStall_o = E_memStall;
 
 /*------------------JUMP/BRANCH-------------------*/
 wire E_takeBranch = 
@@ -297,16 +529,44 @@ assign E_takeBranch_o = E_takeBranch;
 wire [31:0] E_JALRaddr/*verilator public_flat_rw*/;
 assign E_JALRaddr = {E_aluPlus[31:1],1'b0};
 
+// FENCE.I invalidates the instruction cache and refetches the next instruction
+wire E_isFENCEI = DE_isFENCE_i & DE_funct3_i[0];
+assign E_fenceI_o = E_isFENCEI & !E_stall_i;
+
+// CSRRW(I) always writes, CSRRS(I)/CSRRC(I) only with a nonzero rs1/uimm
+wire E_isCSRWrite = DE_isCSR_i & (!DE_funct3_i[1] | (DE_rs1Id_i != 6'b0));
+
+// SFENCE.VMA and satp writes change translations, so they refetch too
+wire E_isSFENCE = DE_isSYS_i & (DE_funct3_i == 3'b000) & (DE_funct7_i == 7'b0001001);
+wire E_isSatpWrite = E_isCSRWrite & (DE_csrId_i == 12'h180);
+wire E_isRefetch = E_isFENCEI | E_isSFENCE | E_isSatpWrite;
+assign E_sfence_o        = E_isSFENCE & !E_stall_i;
+assign E_sfenceAddr_o    = E_rs1i;
+assign E_sfenceAsid_o    = E_rs2i[8:0];
+assign E_sfenceAllAddr_o = (DE_rs1Id_i == 6'b0);
+assign E_sfenceAllAsid_o = (DE_rs2Id_i == 6'b0);
+assign E_satpWrite_o     = E_isSatpWrite & !E_stall_i;
+
+// A page fault squashes the access and refetches it. Decode takes the trap
+// when it gets there, so all older instructions have completed.
+assign E_exc_o      = E_pageFault & !E_stall_i;
+assign E_excCause_o = DMemWrite_o ? 5'd15 : 5'd13;
+assign E_excTval_o  = E_addr;
+
 wire E_correctPC = (
         (DE_isJALR_i    && (DE_predictRA_i != E_JALRaddr)   ) ||
-        (DE_isBranch_i  && (E_takeBranch^DE_predictBranch_i))
+        (DE_isBranch_i  && (E_takeBranch^DE_predictBranch_i)) ||
+        E_isRefetch || E_pageFault
 );
 assign E_correctPC_o = E_correctPC;
 
-wire [31:0] E_nextPC = DE_PC_i + (DE_isRV32C_i ? 2 : 4);
+// The only fused jump is auipc+jalr, which is 8 bytes
+wire [31:0] E_nextPC = DE_PC_i + (DE_isFused_i ? 8 : DE_isRV32C_i ? 2 : 4);
 
 wire [31:0] E_PCcorrection = 
+        E_pageFault   ? DE_PC_i :
         DE_isBranch_i ? (DE_predictBranch_i ? E_nextPC : DE_PC_i + DE_Bimm_i) :
+        E_isRefetch   ? E_nextPC :
         /* JALR */      E_JALRaddr;
 
 /*---------------------Output---------------------*/
@@ -320,14 +580,20 @@ wire [63:0] E_result =
 always @(posedge clk_i) begin
         if (!E_stall_i) begin
                 EM_PC_o <= DE_PC_i;
-                EM_instr_o <= DE_instr_i;
-                EM_nop_o <= DE_nop_i;
+                // Long latency ops are retired when they are written back
+                EM_instr_o <= DE_isLongOp_i ? NOP : DE_instr_i;
+                EM_nop_o <= DE_nop_i | DE_isLongOp_i;
+                EM_isFused_o <= DE_isFused_i;
 
                 EM_isLoad_o <= DE_isLoad_i;
                 EM_isStore_o <= DE_isStore_i;
                 EM_isCSR_o <= DE_isCSR_i;
-                EM_isCSRWrite_o <= DE_isCSR_i && (DE_rs1Id_i != 6'b0);
+                EM_isCSRWrite_o <= E_isCSRWrite;
                 EM_isAMO_o <= DE_isAMO_i;
+                EM_isMUL_o <= DE_isMUL_i;
+                EM_mulHigh_o <= !DE_funct3_is_i[0];
+                EM_mulA_o <= E_mulSigned1;
+                EM_mulB_o <= E_mulSigned2;
                 EM_rdId_o <= DE_rdId_i;
                 EM_rs1Id_o <= DE_rs1Id_i;
                 EM_rs2Id_o <= DE_rs2Id_i;
@@ -336,25 +602,55 @@ always @(posedge clk_i) begin
                 EM_funct7_o <= DE_funct7_i;
                 EM_rs2_o <= E_rs2;
                 EM_Eresult_o <= E_result;
-                EM_addr_o <= E_addr;
+                EM_addr_o <= E_paddr;
                 EM_Mdata_o <= DMemRData_i;
                 EM_CSRdata_o <= csrRData_i;
-                EM_wbEnable_o <= DE_wbEnable_i && (DE_rdId_i != 0);
+                EM_wbEnable_o <= DE_wbEnable_i && (DE_rdId_i != 0) &&
+                        !DE_isLongOp_i && !DE_isFPPipe_i;
 
                 EF_correctPC_o <= E_correctPC;
                 EF_PCcorrection_o <= E_PCcorrection;
         end
 
+        if (E_pageFault && !E_stall_i) begin
+                EM_instr_o     <= NOP;
+                EM_nop_o       <= 1'b1;
+                EM_isFused_o   <= 1'b0;
+                EM_isLoad_o    <= 1'b0;
+                EM_isStore_o   <= 1'b0;
+                EM_isAMO_o     <= 1'b0;
+                EM_wbEnable_o  <= 1'b0;
+        end
+
         if (M_flush_i) begin
                 EM_instr_o     <= NOP;
                 EM_nop_o       <= 1'b1;
+                EM_isFused_o   <= 1'b0;
                 EM_isLoad_o    <= 1'b0;
                 EM_isStore_o   <= 1'b0;
                 EM_isCSR_o     <= 1'b0;
+                EM_isCSRWrite_o <= 1'b0;
                 EM_isAMO_o     <= 1'b0;
+                EM_isMUL_o     <= 1'b0;
                 EF_correctPC_o <= 1'b0;
                 EM_wbEnable_o  <= 1'b0;
         end
+
+        if (E_inject) begin
+                EM_instr_o     <= E_injectInstr;
+                EM_nop_o       <= 1'b0;
+                EM_isFused_o   <= 1'b0;
+                EM_isLoad_o    <= 1'b0;
+                EM_isStore_o   <= 1'b0;
+                EM_isCSR_o     <= 1'b0;
+                EM_isCSRWrite_o <= 1'b0;
+                EM_isAMO_o     <= 1'b0;
+                EM_isMUL_o     <= 1'b0;
+                EM_rdId_o      <= E_injectRdId;
+                EM_Eresult_o   <= E_injectData;
+                EF_correctPC_o <= 1'b0;
+                EM_wbEnable_o  <= (E_injectRdId != 6'b0);
+        end
 end
 
 assign HALT_o = (!reset_i && DE_isEBREAK_i);
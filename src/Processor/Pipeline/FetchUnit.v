@@ -5,27 +5,55 @@
  *Author--------Justin Kachele
  *Created-------Tuesday Dec 02, 2025 15:40:10 UTC
  ************************************************/
+/* verilator lint_off WIDTH */
 
-module FetchUnit (
+module FetchUnit #(
+        parameter IFQ_DEPTH = 4         // Fetch queue entries, power of 2
+)(
         input  wire        clk_i,
         input  wire        reset_i,
         // Pipeline Control Signals
-        input  wire        F_stall_i,
+        input  wire        F_stall_i,       // Decode holds its instruction
         input  wire        D_flush_i,
         input  wire        D_predictPC_i,
         input  wire [31:0] D_PCprediction_i,
         input  wire        EM_correctPC_i,
         input  wire [31:0] EM_PCcorrection_i,
-        // Memory Interface
+        output wire        F_fetch_o,       // Fetch takes the instruction at IMemAddr_o
+        output wire [31:0] F_nextPC_o,      // PC of the instruction decode gets next
+        // Instruction Memory Interface
         output wire [31:0] IMemAddr_o,
         input  wire [31:0] IMemData_i,
-        // Decode Unit Interface
+        input  wire        IMemValid_i,
+        input  wire [31:0] IMemData2_i,
+        input  wire        IMemValid2_i,
+        input  wire        IMemFault_i,     // Instruction page fault
+        input  wire [31:0] IMemFaultAddr_i,
+        // Fetch-Decode Interface
         output reg  [31:0] FD_PC_o,
-        output reg  [31:0] FD_instr_o,
+        output reg  [31:0] FD_instr_o,      // Decompressed
         output reg         FD_isRV32C_o,
+        output reg  [7:0]  FD_predecode_o,  // See Predecoder.v
+        output reg  [31:0] FD_instr2_o,     // Next instruction, for fusion
+        output reg         FD_instr2IsRV32C_o,
+        output reg         FD_instr2Valid_o,
+        output reg         FD_fault_o,
+        output reg  [31:0] FD_faultAddr_o,
         output reg         FD_nop_o
 );
 
+/*
+ * Instructions are fetched into a small queue in front of decode, so fetch
+ * keeps going down the predicted path while decode stalls. An empty queue is
+ * bypassed and the fetched instruction goes straight to decode.
+ * Everything in the queue is younger than the instruction in decode, so it is
+ * dropped on any redirect. A redirect from decode while it stalls is held
+ * until decode moves on, since the decision can still change; fetch restarts
+ * after the instruction in decode in case it is dropped.
+ */
+
+localparam IDX_BITS = (IFQ_DEPTH > 1) ? $clog2(IFQ_DEPTH) : 1;
+
 reg [31:0] PC;
 
 wire [31:0] F_PC =
@@ -37,23 +65,127 @@ assign IMemAddr_o = F_PC;
 
 // The 2 LSBs of uncompressed instructions are always 2'b11
 wire F_isCompressed = ~(&IMemData_i[1:0]);
+wire F_instr2IsCompressed = ~(&IMemData2_i[1:0]);
+
+/*--------------------PREDECODE-------------------*/
+// Compressed instructions are expanded before the fetch queue, so decode
+// starts from 32 bit instructions
+wire [31:0] F_instr;
+wire [31:0] F_instr2;
+wire [7:0]  F_predecode;
+Decompressor decomp(IMemData_i, F_instr);
+Decompressor decomp2(IMemData2_i, F_instr2);
+Predecoder predecode(F_instr, F_predecode);
+
+// A page fault is sent to decode in place of the instruction
+wire F_valid = IMemValid_i | IMemFault_i;
+
+/*--------------------FETCH QUEUE-----------------*/
+reg [31:0] IFQ_PC          [0:IFQ_DEPTH-1];
+reg [31:0] IFQ_instr       [0:IFQ_DEPTH-1];
+reg        IFQ_isRV32C     [0:IFQ_DEPTH-1];
+reg [7:0]  IFQ_predecode   [0:IFQ_DEPTH-1];
+reg [31:0] IFQ_instr2      [0:IFQ_DEPTH-1];
+reg        IFQ_instr2IsRV32C [0:IFQ_DEPTH-1];
+reg        IFQ_instr2Valid [0:IFQ_DEPTH-1];
+reg        IFQ_fault       [0:IFQ_DEPTH-1];
+reg [31:0] IFQ_faultAddr   [0:IFQ_DEPTH-1];
+
+reg [IDX_BITS-1:0] IFQ_head = 0;
+reg [IDX_BITS-1:0] IFQ_tail = 0;
+reg [IDX_BITS:0]   IFQ_count = 0;
+
+/*verilator public_flat_rw_on*/
+reg [31:0] ifqFetchCount = 0;           // Instructions fetched while decode stalled
+/*verilator public_off*/
+
+wire F_take  = !F_stall_i;                              // Decode takes FD
+wire F_drop  = D_flush_i || D_predictPC_i || EM_correctPC_i;
+wire F_hold  = F_stall_i && D_predictPC_i;              // Decode redirect waits
+wire F_queue = !F_drop && (IFQ_count != 0);             // Decode gets the head
+
+wire F_room  = F_drop || (IFQ_count != IFQ_DEPTH) || F_take;
+assign F_fetch_o = !reset_i && !D_flush_i && !F_hold && F_room;
+
+wire F_got   = F_fetch_o && F_valid;
+wire F_push  = F_got && (F_queue || !F_take);
+wire F_pop   = F_take && F_queue;
+
+wire [IDX_BITS-1:0] IFQ_wIdx = F_drop ? 0 : IFQ_tail;
+
+assign F_nextPC_o = F_queue ? IFQ_PC[IFQ_head] : F_PC;
+
+// Where fetch restarts when a held decode redirect is dropped
+wire [31:0] FD_nextPC = FD_PC_o + (FD_isRV32C_o ? 2 : 4);
 
 always @(posedge clk_i) begin
-        if (!F_stall_i) begin
-                FD_instr_o <= IMemData_i;
-                FD_PC_o <= F_PC;
-                FD_isRV32C_o <= F_isCompressed;
-                // Add 2 for compressed instructions and 4 for uncompressed
-                PC <= F_PC + (F_isCompressed ? 2 : 4);
+        if (F_take) begin
+                if (F_queue) begin
+                        FD_instr_o <= IFQ_instr[IFQ_head];
+                        FD_PC_o <= IFQ_PC[IFQ_head];
+                        FD_isRV32C_o <= IFQ_isRV32C[IFQ_head];
+                        FD_predecode_o <= IFQ_predecode[IFQ_head];
+                        FD_instr2_o <= IFQ_instr2[IFQ_head];
+                        FD_instr2IsRV32C_o <= IFQ_instr2IsRV32C[IFQ_head];
+                        FD_instr2Valid_o <= IFQ_instr2Valid[IFQ_head];
+                        FD_fault_o <= IFQ_fault[IFQ_head];
+                        FD_faultAddr_o <= IFQ_faultAddr[IFQ_head];
+                end else begin
+                        FD_instr_o <= F_instr;
+                        FD_PC_o <= F_PC;
+                        FD_isRV32C_o <= F_isCompressed;
+                        FD_predecode_o <= F_predecode;
+                        FD_instr2_o <= F_instr2;
+                        FD_instr2IsRV32C_o <= F_instr2IsCompressed;
+                        FD_instr2Valid_o <= IMemValid2_i;
+                        FD_fault_o <= IMemFault_i;
+                        FD_faultAddr_o <= IMemFaultAddr_i;
+                end
+        end
+
+        if (F_push) begin
+                IFQ_instr[IFQ_wIdx] <= F_instr;
+                IFQ_PC[IFQ_wIdx] <= F_PC;
+                IFQ_isRV32C[IFQ_wIdx] <= F_isCompressed;
+                IFQ_predecode[IFQ_wIdx] <= F_predecode;
+                IFQ_instr2[IFQ_wIdx] <= F_instr2;
+                IFQ_instr2IsRV32C[IFQ_wIdx] <= F_instr2IsCompressed;
+                IFQ_instr2Valid[IFQ_wIdx] <= IMemValid2_i;
+                IFQ_fault[IFQ_wIdx] <= IMemFault_i;
+                IFQ_faultAddr[IFQ_wIdx] <= IMemFaultAddr_i;
         end
 
-        FD_nop_o <= D_flush_i | reset_i;
+        if (F_drop) begin
+                IFQ_head  <= 0;
+                IFQ_tail  <= F_push ? 1 : 0;
+                IFQ_count <= F_push ? 1 : 0;
+        end else begin
+                if (F_pop)
+                        IFQ_head <= IFQ_head + 1;
+                if (F_push)
+                        IFQ_tail <= IFQ_tail + 1;
+                IFQ_count <= IFQ_count + F_push - F_pop;
+        end
+
+        if (F_push && F_stall_i)
+                ifqFetchCount <= ifqFetchCount + 1;
+
+        // Add 2 for compressed instructions and 4 for uncompressed
+        // Hold the PC (and any redirect) on a cache miss or a full queue
+        PC <= F_hold ? FD_nextPC :
+              F_got  ? F_PC + (F_isCompressed ? 2 : 4) : F_PC;
+
+        // Send a bubble to decode on a cache miss. FD stays empty while stalled
+        FD_nop_o <= D_flush_i | reset_i | (F_take ? !(F_queue || F_got) : FD_nop_o);
 
         if (reset_i) begin
                 PC <= 0;
+                IFQ_head  <= 0;
+                IFQ_tail  <= 0;
+                IFQ_count <= 0;
         end
 
 end
 
 endmodule
-
+/* verilator lint_on WIDTH */
@@ -14,6 +14,9 @@ module MemoryUnit (
         output wire [31:0] DMemWAddr_o,
         output wire [63:0] DMemWData_o,
         output wire [4:0]  DMemWMask_o,
+        output wire        DMemWAtomic_o,
+        output wire [31:0] DMemWatchAddr_o,
+        input  wire        DMemWatchLost_i,
         output wire [31:0] IO_memAddr_o,
         input  wire [31:0] IO_memRData_i,
         output wire [31:0] IO_memWData_o,
@@ -23,14 +26,21 @@ module MemoryUnit (
         output wire [31:0] csrWData_o,
         output wire        csrWEnable_o,
         output wire        csrInstStep_o,
+        output wire        csrInstFused_o,
         // Execute Unit Interface
         input  wire [31:0] EM_PC_i,
         input  wire [31:0] EM_instr_i,
         input  wire        EM_nop_i,
+        input  wire        EM_isFused_i,
         input  wire        EM_isLoad_i,
         input  wire        EM_isStore_i,
         input  wire        EM_isCSR_i,
+        input  wire        EM_isCSRWrite_i,     // Not a read only csrr
         input  wire        EM_isAMO_i,
+        input  wire        EM_isMUL_i,
+        input  wire        EM_mulHigh_i,
+        input  wire signed [32:0] EM_mulA_i,
+        input  wire signed [32:0] EM_mulB_i,
         input  wire [5:0]  EM_rdId_i,
         input  wire [5:0]  EM_rs1Id_i,
         input  wire [5:0]  EM_rs2Id_i,
@@ -43,6 +53,7 @@ module MemoryUnit (
         input  wire [63:0] EM_Mdata_i,
         input  wire [31:0] EM_CSRdata_i,
         input  wire        EM_wbEnable_i,
+        output wire [63:0] M_fwdData_o,
         // Writeback Unit Interface
         output reg  [31:0] MW_PC_o,
         output reg  [31:0] MW_instr_o,
@@ -65,6 +76,10 @@ wire M_addressReserved = (EM_addr_i == MM_reservedAddress);
 // Store Conditional succeeds if the address is reserved and hasent been modified
 wire M_scWriteable = M_addressReserved & ~MM_reservedChanged;
 
+// The data cache watches the reserved line. Once it leaves the cache another
+// core may have written it.
+assign DMemWatchAddr_o = MM_reservedAddress;
+
 always @(posedge clk_i) begin
         // Set reserved address and flag
         if (EM_isAMO_i & M_isLR) begin
@@ -75,6 +90,9 @@ always @(posedge clk_i) begin
         else if ((EM_isStore_i || EM_isAMO_i) && M_addressReserved) begin
                 MM_reservedChanged <= 1'b1;
         end
+        else if (DMemWatchLost_i) begin
+                MM_reservedChanged <= 1'b1;
+        end
 end
 
 /*----------------------STORE---------------------*/
@@ -148,6 +166,7 @@ assign IO_memWData_o = EM_rs2_i[31:0];
 assign DMemWAddr_o = EM_addr_i;
 assign DMemWData_o = M_storeData;
 assign DMemWMask_o = {5{(M_storeEnable) & M_isRAM}} & M_storeMask;
+assign DMemWAtomic_o = EM_isAMO_i;
 
 /*----------------------LOAD----------------------*/
 wire [15:0] M_memHalf = EM_addr_i[1] ? EM_Mdata_i[31:16] : EM_Mdata_i[15:0];
@@ -170,24 +189,41 @@ always @(*) begin
 end
 
 
+/*--------------------MULTIPLY--------------------*/
+// Operands come from the EM register and the result goes to the MW register
+// so the multiply maps onto DSP blocks with input and output registers.
+// The result can only be forwarded from the end of the memory unit.
+wire signed [65:0] M_multiply = EM_mulA_i * EM_mulB_i;
+wire [31:0] M_mulOut = EM_mulHigh_i ? M_multiply[63:32] : M_multiply[31:0];
+
 /*-----------------------CSR----------------------*/
 assign csrWAddr_o   = EM_isCSR_i ? EM_csrId_i : 12'bZ;
 assign csrWData_o   = EM_isCSR_i ? EM_Eresult_i[31:0] : 32'bZ;
-assign csrWEnable_o = EM_isCSR_i;
+// A read only CSR access must not write back, or a counter updated by
+// hardware would lose the events counted since it was read
+assign csrWEnable_o = EM_isCSRWrite_i;
 
-// Step up instruction counter if not a NOP
+// Step up instruction counter if not a NOP, twice for a fused pair
+reg MW_isFused;
 assign csrInstStep_o  = ~MW_nop_o;
+assign csrInstFused_o = ~MW_nop_o & MW_isFused;
 
 /*------------------------------------------------*/
-wire [63:0] M_wbData =
+// Everything but the multiply is forwarded to execute from here, so a
+// dependent instruction can follow a load, AMO or CSR read without a bubble
+wire [63:0] M_fwdData =
         M_isSC                     ? {63'h7FFFFFFF80000000, M_scWriteable} :
         (EM_isLoad_i | EM_isAMO_i) ? (M_isIO ? {32'hFFFFFFFF, IO_memRData_i} : M_Mdata) :
         EM_isCSR_i                 ? {32'hFFFFFFFF, EM_CSRdata_i} : EM_Eresult_i;
+assign M_fwdData_o = M_fwdData;
+
+wire [63:0] M_wbData = EM_isMUL_i ? {32'hFFFFFFFF, M_mulOut} : M_fwdData;
 
 always @(posedge clk_i) begin
         MW_PC_o <= EM_PC_i;
         MW_instr_o <= EM_instr_i;
         MW_nop_o <= EM_nop_i;
+        MW_isFused <= EM_isFused_i;
 
         MW_rdId_o <= EM_rdId_i;
         MW_wbData_o <= M_wbData;
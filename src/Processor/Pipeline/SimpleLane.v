@@ -0,0 +1,135 @@
+/*************************************************
+ *File----------SimpleLane.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 02:14:37 UTC
+ ************************************************/
+
+module SimpleLane (
+        input  wire        clk_i,
+        input  wire        reset_i,
+        // Pipeline Control Signals
+        input  wire        E_stall_i,
+        input  wire        M_flush_i,
+        input  wire        E_correctPC_i,   // First lane mispredict squashes this lane
+        // Register File Interface
+        output wire [4:0]  rs1Id_o,
+        output wire [4:0]  rs2Id_o,
+        input  wire [31:0] rs1Data_i,
+        input  wire [31:0] rs2Data_i,
+        // Register Forwarding (First Lane)
+        input  wire        EM_wbEnable_i,
+        input  wire [5:0]  EM_rdId_i,
+        input  wire [63:0] M_fwdData_i,
+        input  wire        MW_wbEnable_i,
+        input  wire [5:0]  MW_rdId_i,
+        input  wire [63:0] MW_wbData_i,
+        // Decode Unit Interface
+        input  wire        DE2_valid_i,
+        input  wire [31:0] DE2_PC_i,
+        input  wire [31:0] DE2_instr_i,
+        // Memory Stage
+        output reg         EM2_wbEnable_o,
+        output reg  [4:0]  EM2_rdId_o,
+        output reg  [31:0] EM2_result_o,
+        // Write Back Stage
+        output reg         MW2_valid_o,
+        output reg         MW2_wbEnable_o,
+        output reg  [4:0]  MW2_rdId_o,
+        output reg  [31:0] MW2_wbData_o
+);
+
+/*
+ * Execute and memory stages of the second issue lane. Decode only issues base
+ * integer ALU ops (LUI, AUIPC, OP-IMM, OP) here, so the result is ready at the
+ * end of execute and the memory stage only carries it to write back.
+ * The instruction is always younger than the one in the first lane, so its
+ * own results are forwarded ahead of the first lane's at each stage.
+ */
+reg EM2_valid;
+
+/*---------------------DECODE---------------------*/
+wire [4:0]  E2_rdId  = DE2_instr_i[11:7];
+wire [4:0]  E2_rs1Id = DE2_instr_i[19:15];
+wire [4:0]  E2_rs2Id = DE2_instr_i[24:20];
+wire [2:0]  E2_funct3 = DE2_instr_i[14:12];
+wire        E2_funct7_5 = DE2_instr_i[30];
+wire [31:0] E2_Iimm = {{21{DE2_instr_i[31]}}, DE2_instr_i[30:20]};
+wire [31:0] E2_Uimm = {DE2_instr_i[31:12], 12'b0};
+
+wire E2_isLUI   = (DE2_instr_i[6:2] == 5'b01101);
+wire E2_isAUIPC = (DE2_instr_i[6:2] == 5'b00101);
+wire E2_isALUR  = (DE2_instr_i[6:2] == 5'b01100);
+
+/*-------------------FORWARDING-------------------*/
+assign rs1Id_o = E2_rs1Id;
+assign rs2Id_o = E2_rs2Id;
+
+wire E2fwd_rs1  = EM2_wbEnable_o && (EM2_rdId_o == E2_rs1Id);
+wire E2fwd_rs2  = EM2_wbEnable_o && (EM2_rdId_o == E2_rs2Id);
+wire EMfwd_rs1  = EM_wbEnable_i && (EM_rdId_i == {1'b0, E2_rs1Id});
+wire EMfwd_rs2  = EM_wbEnable_i && (EM_rdId_i == {1'b0, E2_rs2Id});
+wire W2fwd_rs1  = MW2_wbEnable_o && (MW2_rdId_o == E2_rs1Id);
+wire W2fwd_rs2  = MW2_wbEnable_o && (MW2_rdId_o == E2_rs2Id);
+wire EWfwd_rs1  = MW_wbEnable_i && (MW_rdId_i == {1'b0, E2_rs1Id});
+wire EWfwd_rs2  = MW_wbEnable_i && (MW_rdId_i == {1'b0, E2_rs2Id});
+
+wire [31:0] E2_rs1 = E2fwd_rs1 ? EM2_result_o :
+        EMfwd_rs1 ? M_fwdData_i[31:0] :
+        W2fwd_rs1 ? MW2_wbData_o :
+        EWfwd_rs1 ? MW_wbData_i[31:0] : rs1Data_i;
+
+wire [31:0] E2_rs2 = E2fwd_rs2 ? EM2_result_o :
+        EMfwd_rs2 ? M_fwdData_i[31:0] :
+        W2fwd_rs2 ? MW2_wbData_o :
+        EWfwd_rs2 ? MW_wbData_i[31:0] : rs2Data_i;
+
+/*-----------------------ALU----------------------*/
+wire [31:0] E2_in2   = E2_isALUR ? E2_rs2 : E2_Iimm;
+wire [4:0]  E2_shamt = E2_in2[4:0];
+wire [32:0] E2_minus = {1'b1, ~E2_in2} + {1'b0, E2_rs1} + 33'b1;
+wire        E2_LT    = (E2_rs1[31] ^ E2_in2[31]) ? E2_rs1[31] : E2_minus[32];
+wire        E2_LTU   = E2_minus[32];
+
+reg [31:0] E2_aluOut;
+always @(*) begin
+        case (E2_funct3)
+                3'b000: E2_aluOut = (E2_isALUR & E2_funct7_5) ? E2_minus[31:0] :
+                                                                E2_rs1 + E2_in2;
+                3'b001: E2_aluOut = E2_rs1 << E2_shamt;
+                3'b010: E2_aluOut = {31'b0, E2_LT};
+                3'b011: E2_aluOut = {31'b0, E2_LTU};
+                3'b100: E2_aluOut = E2_rs1 ^ E2_in2;
+                3'b101: E2_aluOut = E2_funct7_5 ?
+                                $signed(E2_rs1) >>> E2_shamt : E2_rs1 >> E2_shamt;
+                3'b110: E2_aluOut = E2_rs1 | E2_in2;
+                3'b111: E2_aluOut = E2_rs1 & E2_in2;
+        endcase
+end
+
+wire [31:0] E2_result =
+        E2_isLUI   ? E2_Uimm :
+        E2_isAUIPC ? DE2_PC_i + E2_Uimm : E2_aluOut;
+
+/*------------------------------------------------*/
+always @(posedge clk_i) begin
+        if (!E_stall_i) begin
+                EM2_valid      <= DE2_valid_i && !E_correctPC_i;
+                EM2_wbEnable_o <= DE2_valid_i && !E_correctPC_i && (E2_rdId != 5'b0);
+                EM2_rdId_o     <= E2_rdId;
+                EM2_result_o   <= E2_result;
+        end
+
+        if (M_flush_i || reset_i) begin
+                EM2_valid      <= 1'b0;
+                EM2_wbEnable_o <= 1'b0;
+        end
+
+        MW2_valid_o    <= EM2_valid && !reset_i;
+        MW2_wbEnable_o <= EM2_wbEnable_o && !reset_i;
+        MW2_rdId_o     <= EM2_rdId_o;
+        MW2_wbData_o   <= EM2_result_o;
+end
+
+endmodule
@@ -0,0 +1,59 @@
+/*************************************************
+ *File----------Predecoder.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 07:48:15 UTC
+ ************************************************/
+
+module Predecoder (
+        input  wire [31:0] instr_i,     // Decompressed
+        output wire [7:0]  predecode_o
+);
+
+/*
+ * Instruction class bits worked out in fetch, so decode gets them from the
+ * fetch-decode register. Macro-op fusion never changes them for the first
+ * instruction of a pair, except that auipc+jalr becomes a JAL.
+ *   [0] Branch          [4] rs1 is a FP register
+ *   [1] JAL             [5] rs2 is a FP register
+ *   [2] JALR            [6] Long latency op (DIV/REM, FDIV.S/D, FSQRT.S/D)
+ *   [3] rd is a FP reg  [7] Pipelined FP op (FADD, FSUB, FMUL, FMA)
+ */
+
+wire isBranch = (instr_i[6:2] == 5'b11000);
+wire isJAL    = (instr_i[6:2] == 5'b11011);
+wire isJALR   = (instr_i[6:2] == 5'b11001);
+wire isStore  = (instr_i[6:3] == 4'b0100);
+wire isALUR   = (instr_i[6:2] == 5'b01100);
+wire isFPU    = (instr_i[6:5] == 2'b10);
+
+// rd is a FP reg if op is FLW, FMA, R-Type FPU, FCVT.S.W(U), or FMV.W.X
+wire rdIsFP = (instr_i[6:2] == 5'b00001)    || // FLW
+        (instr_i[6:4] == 3'b100)            || // FMA F(N)MADD / F(N)MSUB
+        (isFPU && ((instr_i[31] == 1'b0)    || // R-Type FPU Instr
+        (instr_i[31:28] == 4'b1101)         || // FCVT.S.W(U)
+        (instr_i[31:28] == 4'b1111)));         // FMV.W.X
+
+// rs1 is a FP reg if op is FPU except for FCVT.S.W(U) and FMV.W.X
+wire rs1IsFP = isFPU &&
+        !((instr_i[4:2]   == 3'b100) && (
+          (instr_i[31:28] == 4'b1101) ||     // FCVT.S.W(U)
+          (instr_i[31:28] == 4'b1111)));      // FMV.W.X
+
+// rs2 is a FP reg if op is FPU or FSW
+wire rs2IsFP = isFPU || (isStore && instr_i[2]);
+
+wire isDIV   = isALUR && (instr_i[31:25] == 7'b0000001) && instr_i[14];
+// Only formats with a background unit in the FPU (S and D), anything marked
+// long is dropped from the pipeline and left to that unit to write back
+wire isFDIV  = (instr_i[6:2] == 5'b10100) && (instr_i[31:27] == 5'b00011) && !instr_i[26];
+wire isFSQRT = (instr_i[6:2] == 5'b10100) && (instr_i[31:27] == 5'b01011) && !instr_i[26];
+wire isLongOp = isDIV | isFDIV | isFSQRT;
+
+wire isFPPipe = (instr_i[6:4] == 3'b100) ||
+        ((instr_i[6:2] == 5'b10100) && (instr_i[31:29] == 3'b000) && (instr_i[28:27] != 2'b11));
+
+assign predecode_o = {isFPPipe, isLongOp, rs2IsFP, rs1IsFP, rdIsFP, isJALR, isJAL, isBranch};
+
+endmodule
@@ -0,0 +1,168 @@
+/*************************************************
+ *File----------Prefetcher.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 00:37:24 UTC
+ ************************************************/
+/* verilator lint_off WIDTH */
+
+module Prefetcher #(
+        parameter LINE    = 16,         // Data cache line size in bytes
+        parameter ENTRIES = 16,         // Stride table entries (power of 2)
+        parameter WINDOW  = 32          // Prefetches per accuracy window
+)(
+        input  wire        clk_i,
+        input  wire        reset_i,
+        // Training (Memory Unit)
+        input  wire        trainValid_i,    // Load/store/AMO to RAM in the memory unit
+        input  wire [31:0] trainPC_i,
+        input  wire [31:0] trainAddr_i,
+        // Data Cache Interface
+        output wire        pfValid_o,
+        output wire [31:0] pfAddr_o,
+        input  wire        pfReady_i,       // Request taken (refilled or already cached)
+        input  wire        pfIssue_i,       // Request started a refill
+        input  wire [2:0]  pfUseful_i,      // Demand accesses to prefetched lines
+        input  wire        pfLate_i         // Demand miss waiting on a prefetch
+);
+
+/*
+ * Per-PC stride prefetcher with a next-line fallback.
+ * The table is indexed by the PC of each memory access and remembers its last
+ * address and stride. Once the same stride is seen twice the line that many
+ * strides ahead is prefetched. Strides smaller than a line prefetch the next
+ * line in the direction of the stride. Accesses without a confirmed stride
+ * prefetch the next line.
+ * Only the newest request is kept. The cache takes it when it has no miss of
+ * its own, and drops it if the line is already present.
+ *
+ * The prefetcher throttles itself on accuracy. Every WINDOW issued prefetches
+ * the number that were used picks the level:
+ *   0: Off, retried after 1024 accesses
+ *   1: Stride only, 1 stride ahead
+ *   2: Stride 2 ahead, next-line
+ *   3: Stride 4 ahead, next-line
+ */
+
+localparam IDX_BITS = $clog2(ENTRIES);
+localparam OFF_BITS = $clog2(LINE);
+localparam TAG_BITS = 31 - IDX_BITS;
+
+reg [ENTRIES-1:0]  tblValid = 0;
+reg [TAG_BITS-1:0] tblTag    [0:ENTRIES-1];
+reg [31:0]         tblLast   [0:ENTRIES-1];
+reg [31:0]         tblStride [0:ENTRIES-1];
+reg [1:0]          tblConf   [0:ENTRIES-1];
+
+/*verilator public_flat_rw_on*/
+reg [31:0] issuedCount = 0;             // Prefetches that refilled a line
+reg [31:0] usefulCount = 0;             // Prefetched lines used by a load/store
+reg [31:0] lateCount = 0;               // Prefetches still refilling when used
+reg [31:0] droppedCount = 0;            // Prefetches for lines already cached
+reg [1:0]  level = 2'd2;                // Throttle level
+/*verilator public_off*/
+
+/*--------------------TRAINING--------------------*/
+wire [IDX_BITS-1:0] idx = trainPC_i[IDX_BITS:1];
+wire [TAG_BITS-1:0] tag = trainPC_i[31:IDX_BITS+1];
+wire        tblHit    = tblValid[idx] && (tblTag[idx] == tag);
+wire [31:0] stride    = trainAddr_i - tblLast[idx];
+wire        sameStride = tblHit && (stride == tblStride[idx]) && (stride != 0);
+wire        strideOk  = sameStride && (tblConf[idx] != 0);
+
+/*--------------------PREFETCH ADDRESS------------*/
+wire [31:0] strideDist =
+        (level == 2'd3) ? stride << 2 :
+        (level == 2'd2) ? stride << 1 : stride;
+wire        strideBack = stride[31];
+wire [31:0] strideAbs  = strideBack ? -strideDist : strideDist;
+wire [31:0] lineStep   = strideBack ? -LINE : LINE;
+
+// Short strides move to the neighbouring line
+wire [31:0] strideTarget = (strideAbs < LINE) ? trainAddr_i + lineStep :
+                                                trainAddr_i + strideDist;
+wire [31:0] target = strideOk ? strideTarget : trainAddr_i + LINE;
+
+wire        pfNew = trainValid_i && !reset_i && (level != 0) &&
+                    (strideOk || (level >= 2));
+
+reg         pfValid = 1'b0;
+reg  [31:0] pfAddr;
+
+assign pfValid_o = pfValid;
+assign pfAddr_o  = {pfAddr[31:OFF_BITS], {OFF_BITS{1'b0}}};
+
+/*--------------------THROTTLE--------------------*/
+reg [$clog2(WINDOW):0] winIssued = 0;
+reg [$clog2(WINDOW):0] winUseful = 0;
+reg [9:0]              offCount = 0;
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                tblValid  <= 0;
+                pfValid   <= 1'b0;
+                level     <= 2'd2;
+                winIssued <= 0;
+                winUseful <= 0;
+                offCount  <= 0;
+        end else begin
+                if (trainValid_i) begin
+                        tblValid[idx] <= 1'b1;
+                        tblTag[idx]   <= tag;
+                        tblLast[idx]  <= trainAddr_i;
+                        if (!tblHit) begin
+                                tblStride[idx] <= 0;
+                                tblConf[idx]   <= 0;
+                        end else if (sameStride) begin
+                                if (tblConf[idx] != 2'd3)
+                                        tblConf[idx] <= tblConf[idx] + 1;
+                        end else if (tblConf[idx] != 0) begin
+                                tblConf[idx] <= tblConf[idx] - 1;
+                        end else begin
+                                tblStride[idx] <= stride;
+                        end
+                end
+
+                // Newest request replaces one the cache has not taken
+                if (pfNew) begin
+                        pfValid <= 1'b1;
+                        pfAddr  <= target;
+                end else if (pfReady_i) begin
+                        pfValid <= 1'b0;
+                end
+
+                if (level == 0) begin
+                        if (trainValid_i)
+                                offCount <= offCount + 1;
+                        if (offCount == 10'h3FF) begin
+                                level     <= 2'd1;
+                                winIssued <= 0;
+                                winUseful <= 0;
+                        end
+                end else if (winIssued == WINDOW) begin
+                        if (winUseful < WINDOW / 4)
+                                level <= level - 1;
+                        else if ((winUseful >= WINDOW / 2) && (level != 2'd3))
+                                level <= level + 1;
+                        winIssued <= 0;
+                        winUseful <= 0;
+                        offCount  <= 0;
+                end else begin
+                        winIssued <= winIssued + pfIssue_i;
+                        if (winUseful < WINDOW)
+                                winUseful <= winUseful + pfUseful_i;
+                end
+        end
+
+        if (pfIssue_i)
+                issuedCount <= issuedCount + 1;
+        if (pfValid && pfReady_i && !pfIssue_i)
+                droppedCount <= droppedCount + 1;
+        usefulCount <= usefulCount + pfUseful_i;
+        if (pfLate_i)
+                lateCount <= lateCount + 1;
+end
+
+endmodule
+/* verilator lint_on WIDTH */
@@ -6,35 +6,65 @@
  *Created-------Monday Nov 17, 2025 20:09:17 UTC
  ************************************************/
 
-module Processor(
+module Processor #(
+        parameter HARTID = 0
+)(
         input  wire clk_i,
         input  wire reset_i,
         // Memory
-        output wire [31:0] IMemAddr_o,
-        input  wire [31:0] IMemData_i,
-        output wire [31:0] DMemRAddr_o,
-        input  wire [63:0] DMemRData_i,
-        output wire [31:0] DMemWAddr_o,
-        output wire [63:0] DMemWData_o,
-        output wire [4:0]  DMemWMask_o,
+        output wire        IMemReqValid_o,
+        input  wire        IMemReqReady_i,
+        output wire [31:0] IMemReqAddr_o,
+        output wire [7:0]  IMemReqLen_o,
+        input  wire        IMemRespValid_i,
+        input  wire [31:0] IMemRespData_i,
+        output wire        DMemReqValid_o,
+        input  wire        DMemReqReady_i,
+        output wire        DMemReqWrite_o,
+        output wire [31:0] DMemReqAddr_o,
+        output wire [7:0]  DMemReqLen_o,
+        output wire        DMemWValid_o,
+        input  wire        DMemWReady_i,
+        output wire [31:0] DMemWData_o,
+        input  wire        DMemRespValid_i,
+        input  wire [31:0] DMemRespData_i,
+        // Data Cache Coherence
+        input  wire        DMemSnoopValid_i,
+        input  wire [31:0] DMemSnoopAddr_i,
+        output wire        DMemSnoopAck_o,
         // Memory Mapped IO
         output wire [31:0] IO_memAddr_o,
         input  wire [31:0] IO_memRData_i,
         output wire [31:0] IO_memWData_o,
-        output wire        IO_memWr_o
+        output wire        IO_memWr_o,
+        output wire        IO_memReq_o,     // IO access in execute
+        input  wire        IO_memGrant_i,   // Shared IO port granted
+        // CLINT Interrupts and Timer
+        input  wire        timerIrq_i,
+        input  wire        softIrq_i,
+        input  wire [63:0] mtime_i
 );
 
 /******************************************************************************
  ----------------------------------Registers-----------------------------------
  ******************************************************************************/
-wire [63:0] rs1Data;
-wire [63:0] rs2Data;
-wire [63:0] rs3Data;
+wire [31:0] rs1Data;
+wire [31:0] rs2Data;
+wire [63:0] fpRs1Data;
+wire [63:0] fpRs2Data;
+wire [63:0] fpRs3Data;
 wire [5:0]  rdId;
 wire [63:0] rdData;
-wire [5:0]  rs1Id;
-wire [5:0]  rs2Id;
-wire [5:0]  rs3Id;
+wire [4:0]  rs1Id;
+wire [4:0]  rs2Id;
+wire [4:0]  rs3Id;
+wire        fpWrEnable;
+wire [4:0]  fpWrId;
+wire [63:0] fpWrData;
+wire [4:0]  rs1Id2;
+wire [4:0]  rs2Id2;
+wire [31:0] rs1Data2;
+wire [31:0] rs2Data2;
 
 // CSR
 wire [11:0] csrWAddr;
@@ -43,6 +73,9 @@ wire        csrWEnable;
 wire [11:0] csrRAddr;
 wire [31:0] csrRData;
 wire        csrInstStep;
+wire        csrInstFused;
+wire        csrInstStep2;
+wire [15:0] csrHpmEvents;
 wire [4:0]  csrFFlagsSet;
 wire [2:0]  csrFRM;
 wire [63:0] csrMStatus;
@@ -51,14 +84,21 @@ wire [31:0] csrMideleg;
 wire [31:0] csrMtvec;
 wire [31:0] csrMepc;
 wire [31:0] csrMCause;
+wire [31:0] csrMtval;
+wire [31:0] csrMip;
+wire [31:0] csrMie;
 wire [31:0] csrStvec;
 wire [31:0] csrSepc;
 wire [31:0] csrSCause;
+wire [31:0] csrStval;
+wire [31:0] csrSatp;
 wire [6:0]  csrMStatusSet; // {MPP[1:0], MPIE, MIE, SPP, SPIE, SIE}
 wire [31:0] csrMepcSet;
 wire [31:0] csrMCauseSet;
+wire [31:0] csrMtvalSet;
 wire [31:0] csrSepcSet;
 wire [31:0] csrSCauseSet;
+wire [31:0] csrStvalSet;
 wire        csrTrapSetEn;
 
 RegisterFile registers(
@@ -66,15 +106,31 @@ RegisterFile registers(
         .reset_i(reset_i),
         .rdId_i(rdId),
         .rdData_i(rdData),
+        .fpWrEnable_i(fpWrEnable),
+        .fpWrId_i(fpWrId),
+        .fpWrData_i(fpWrData),
+        .intWrEnable_i(MW2_wbEnable),
+        .intWrId_i(MW2_rdId),
+        .intWrData_i(MW2_wbData),
         .rs1Id_i(rs1Id),
         .rs2Id_i(rs2Id),
-        .rs3Id_i(rs3Id),
         .rs1Data_o(rs1Data),
         .rs2Data_o(rs2Data),
-        .rs3Data_o(rs3Data)
+        .fpRs1Id_i(rs1Id),
+        .fpRs2Id_i(rs2Id),
+        .fpRs3Id_i(rs3Id),
+        .fpRs1Data_o(fpRs1Data),
+        .fpRs2Data_o(fpRs2Data),
+        .fpRs3Data_o(fpRs3Data),
+        .rs1Id2_i(rs1Id2),
+        .rs2Id2_i(rs2Id2),
+        .rs1Data2_o(rs1Data2),
+        .rs2Data2_o(rs2Data2)
 );
 
-CSR_RegFile csr(
+CSR_RegFile #(
+        .HARTID(HARTID)
+)csr(
         .clk_i(clk_i),
         .reset_i(reset_i),
         .csrWAddr_i(csrWAddr),
@@ -83,6 +139,12 @@ CSR_RegFile csr(
         .csrRAddr_i(csrRAddr),
         .csrRData_o(csrRData),
         .csrInstStep_i(csrInstStep),
+        .csrInstFused_i(csrInstFused),
+        .csrInstStep2_i(csrInstStep2),
+        .csrHpmEvents_i(csrHpmEvents),
+        .timerIrq_i(timerIrq_i),
+        .softIrq_i(softIrq_i),
+        .mtime_i(mtime_i),
         .csrFFlagsSet_i(csrFFlagsSet),
         .csrFRM_o(csrFRM),
         .csrMStatus_o(csrMStatus),
@@ -91,14 +153,21 @@ CSR_RegFile csr(
         .csrMtvec_o(csrMtvec),
         .csrMepc_o(csrMepc),
         .csrMCause_o(csrMCause),
+        .csrMtval_o(csrMtval),
+        .csrMip_o(csrMip),
+        .csrMie_o(csrMie),
         .csrStvec_o(csrStvec),
         .csrSepc_o(csrSepc),
         .csrSCause_o(csrSCause),
+        .csrStval_o(csrStval),
+        .csrSatp_o(csrSatp),
         .csrMStatusSet_i(csrMStatusSet),
         .csrMepcSet_i(csrMepcSet),
         .csrMCauseSet_i(csrMCauseSet),
+        .csrMtvalSet_i(csrMtvalSet),
         .csrSepcSet_i(csrSepcSet),
         .csrSCauseSet_i(csrSCauseSet),
+        .csrStvalSet_i(csrStvalSet),
         .csrTrapSetEn_i(csrTrapSetEn)
 );
 
@@ -114,6 +183,9 @@ wire D_flush;
 wire E_flush;
 wire M_flush;
 wire dataHazard;
+wire longHazard;
+wire csrHazard;
+wire loadUseStall;
 wire D_isPrivileged;
 wire D_predictPC;
 wire [31:0] D_PCprediction;
@@ -122,8 +194,6 @@ wire [31:0] D_PCprediction;
 ControlUnit control(
         .HALT_i(HALT),
         .dataHazard_i(dataHazard),
-        .D_isPrivileged_i(D_isPrivileged),
-        .EM_isCSRWrite_i(EM_isCSRWrite),
         .aluBusy_i(aluBusy),
         .E_correctPC_i(E_correctPC),
         .F_stall_o(F_stall),
@@ -140,7 +210,51 @@ ControlUnit control(
 wire [31:0] FD_PC;
 wire [31:0] FD_instr;
 wire        FD_isRV32C;
+wire [7:0]  FD_predecode;
+wire        FD_instr2IsRV32C;
 wire        FD_nop;
+wire [31:0] FD_instr2;
+wire        FD_instr2Valid;
+wire        FD_fault;
+wire [31:0] FD_faultAddr;
+wire [31:0] IMemAddr;
+wire        F_fetch;
+wire [31:0] F_nextPC;
+wire [31:0] IMemData;
+wire        IMemValid;
+wire [31:0] IMemData2;
+wire        IMemValid2;
+wire        E_fenceI;
+wire [19:0] IMemPageA;
+wire [19:0] IMemPageB;
+wire [1:0]  IMemPageValid;
+wire        IMemXlateMiss;
+wire [31:0] IMemXlateAddr;
+wire        IMemFault;
+
+ICache icache(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .addr_i(IMemAddr),
+        .fetch_i(F_fetch),
+        .instr_o(IMemData),
+        .valid_o(IMemValid),
+        .instr2_o(IMemData2),
+        .valid2_o(IMemValid2),
+        .invalidate_i(E_fenceI),
+        .pageA_i(IMemPageA),
+        .pageB_i(IMemPageB),
+        .pageValid_i(IMemPageValid),
+        .xlateMiss_o(IMemXlateMiss),
+        .xlateAddr_o(IMemXlateAddr),
+        .memReqValid_o(IMemReqValid_o),
+        .memReqReady_i(IMemReqReady_i),
+        .memReqAddr_o(IMemReqAddr_o),
+        .memReqLen_o(IMemReqLen_o),
+        .memRespValid_i(IMemRespValid_i),
+        .memRespData_i(IMemRespData_i)
+);
+
 FetchUnit fetch(
         .clk_i(clk_i),
         .reset_i(reset_i),
@@ -150,11 +264,24 @@ FetchUnit fetch(
         .D_PCprediction_i(D_PCprediction),
         .EM_correctPC_i(EF_correctPC),
         .EM_PCcorrection_i(EF_PCcorrection),
-        .IMemAddr_o(IMemAddr_o),
-        .IMemData_i(IMemData_i),
+        .F_fetch_o(F_fetch),
+        .F_nextPC_o(F_nextPC),
+        .IMemAddr_o(IMemAddr),
+        .IMemData_i(IMemData),
+        .IMemValid_i(IMemValid),
+        .IMemData2_i(IMemData2),
+        .IMemValid2_i(IMemValid2),
+        .IMemFault_i(IMemFault),
+        .IMemFaultAddr_i(IMemXlateAddr),
         .FD_PC_o(FD_PC),
         .FD_instr_o(FD_instr),
         .FD_isRV32C_o(FD_isRV32C),
+        .FD_predecode_o(FD_predecode),
+        .FD_instr2_o(FD_instr2),
+        .FD_instr2IsRV32C_o(FD_instr2IsRV32C),
+        .FD_instr2Valid_o(FD_instr2Valid),
+        .FD_fault_o(FD_fault),
+        .FD_faultAddr_o(FD_faultAddr),
         .FD_nop_o(FD_nop)
 );
 /******************************************************************************
@@ -163,6 +290,7 @@ FetchUnit fetch(
 wire [31:0] DE_PC;
 wire [31:0] DE_instr;
 wire        DE_isRV32C;
+wire        DE_isFused;
 wire        DE_nop;
 
 wire        DE_isLUI;
@@ -197,16 +325,24 @@ wire [31:0] DE_Bimm;
 wire [31:0] DE_Uimm;
 
 wire        DE_isRV32M;
+wire        DE_isBitManip;
 wire        DE_isMUL;
 wire        DE_isDIV;
+wire        DE_isLongOp;
+wire        DE_isFPPipe;
 
 wire        DE_wbEnable; // !isBranch && !isStore && rdId != 0
 
 wire        DE_predictBranch;
 wire [BP_ADDR_BITS-1:0] DE_bhtIndex;
 wire [31:0] DE_predictRA;
+wire        DE2_valid;
+wire [31:0] DE2_PC;
+wire [31:0] DE2_instr;
+wire [1:0]  D_privilege;
+wire [1:0]  D_fetchPrivilege;
 
-localparam BP_ADDR_BITS = 12;
+localparam BP_ADDR_BITS = 14;
 localparam BHT_SIZE = 1 << BP_ADDR_BITS;
 localparam BH_BITS = 9;
 
@@ -226,27 +362,55 @@ DecodeUnit #(
         .D_PCprediction_o(D_PCprediction),
         .dataHazard_o(dataHazard),
         .D_isPrivileged_o(D_isPrivileged),
+        .longHazard_o(longHazard),
+        .csrHazard_o(csrHazard),
+        .loadUseStall_o(loadUseStall),
+        .E_longIssue_i(E_longIssue),
+        .E_longDone_i(E_longDone),
+        .E_longDoneRdId_i(E_longDoneRdId),
+        .E_fpPipeDone_i(E_fpPipeDone),
+        .E_fpPipeDoneRdId_i(E_fpPipeDoneRdId),
+        .E_exc_i(E_exc),
+        .E_excCause_i(E_excCause),
+        .E_excTval_i(E_excTval),
+        .D_privilege_o(D_privilege),
+        .D_fetchPrivilege_o(D_fetchPrivilege),
         .csrMStatus_i(csrMStatus),
         .csrMedeleg_i(csrMedeleg),
+        .csrMideleg_i(csrMideleg),
+        .csrMip_i(csrMip),
+        .csrMie_i(csrMie),
         .csrMtvec_i(csrMtvec),
         .csrMepc_i(csrMepc),
         .csrMCause_i(csrMCause),
+        .csrMtval_i(csrMtval),
         .csrStvec_i(csrStvec),
         .csrSepc_i(csrSepc),
         .csrSCause_i(csrSCause),
+        .csrStval_i(csrStval),
         .csrMStatusSet_o(csrMStatusSet),
         .csrMepcSet_o(csrMepcSet),
         .csrMCauseSet_o(csrMCauseSet),
+        .csrMtvalSet_o(csrMtvalSet),
         .csrSepcSet_o(csrSepcSet),
         .csrSCauseSet_o(csrSCauseSet),
+        .csrStvalSet_o(csrStvalSet),
         .csrTrapSetEn_o(csrTrapSetEn),
+        .F_nextPC_i(F_nextPC),
         .FD_PC_i(FD_PC),
         .FD_instr_i(FD_instr),
         .FD_isRV32C_i(FD_isRV32C),
+        .FD_predecode_i(FD_predecode),
+        .FD_instr2_i(FD_instr2),
+        .FD_instr2IsRV32C_i(FD_instr2IsRV32C),
+        .FD_instr2Valid_i(FD_instr2Valid),
+        .FD_fault_i(FD_fault),
+        .FD_faultAddr_i(FD_faultAddr),
         .FD_nop_i(FD_nop),
         .DE_PC_o(DE_PC),
         .DE_instr_o(DE_instr),
         .DE_isRV32C_o(DE_isRV32C),
+        .DE_isFused_o(DE_isFused),
         .DE_nop_o(DE_nop),
         .DE_isLUI_o(DE_isLUI),
         .DE_isAUIPC_o(DE_isAUIPC),
@@ -276,12 +440,56 @@ DecodeUnit #(
         .DE_Bimm_o(DE_Bimm),
         .DE_Uimm_o(DE_Uimm),
         .DE_isRV32M_o(DE_isRV32M),
+        .DE_isBitManip_o(DE_isBitManip),
         .DE_isMUL_o(DE_isMUL),
         .DE_isDIV_o(DE_isDIV),
+        .DE_isLongOp_o(DE_isLongOp),
+        .DE_isFPPipe_o(DE_isFPPipe),
         .DE_wbEnable_o(DE_wbEnable),
         .DE_predictBranch_o(DE_predictBranch),
         .DE_bhtIndex_o(DE_bhtIndex),
-        .DE_predictRA_o(DE_predictRA)
+        .DE_predictRA_o(DE_predictRA),
+        .DE2_valid_o(DE2_valid),
+        .DE2_PC_o(DE2_PC),
+        .DE2_instr_o(DE2_instr)
+);
+
+/******************************************************************************
+ ------------------------------SECOND ISSUE LANE------------------------------*
+ ******************************************************************************/
+wire        EM2_wbEnable;
+wire [4:0]  EM2_rdId;
+wire [31:0] EM2_result;
+wire        MW2_wbEnable;
+wire [4:0]  MW2_rdId;
+wire [31:0] MW2_wbData;
+
+SimpleLane lane2(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .E_stall_i(E_stall),
+        .M_flush_i(M_flush),
+        .E_correctPC_i(E_correctPC),
+        .rs1Id_o(rs1Id2),
+        .rs2Id_o(rs2Id2),
+        .rs1Data_i(rs1Data2),
+        .rs2Data_i(rs2Data2),
+        .EM_wbEnable_i(EM_wbEnable),
+        .EM_rdId_i(EM_rdId),
+        .M_fwdData_i(M_fwdData),
+        .MW_wbEnable_i(MW_wbEnable),
+        .MW_rdId_i(MW_rdId),
+        .MW_wbData_i(MW_wbData),
+        .DE2_valid_i(DE2_valid),
+        .DE2_PC_i(DE2_PC),
+        .DE2_instr_i(DE2_instr),
+        .EM2_wbEnable_o(EM2_wbEnable),
+        .EM2_rdId_o(EM2_rdId),
+        .EM2_result_o(EM2_result),
+        .MW2_valid_o(csrInstStep2),
+        .MW2_wbEnable_o(MW2_wbEnable),
+        .MW2_rdId_o(MW2_rdId),
+        .MW2_wbData_o(MW2_wbData)
 );
 
 /******************************************************************************
@@ -290,12 +498,17 @@ DecodeUnit #(
 wire [31:0] EM_PC;
 wire [31:0] EM_instr;
 wire        EM_nop;
+wire        EM_isFused;
 
 wire        EM_isLoad;
 wire        EM_isStore;
 wire        EM_isCSR;
 wire        EM_isCSRWrite;
 wire        EM_isAMO;
+wire        EM_isMUL;
+wire        EM_mulHigh;
+wire signed [32:0] EM_mulA;
+wire signed [32:0] EM_mulB;
 wire [5:0]  EM_rdId;
 wire [5:0]  EM_rs1Id;
 wire [5:0]  EM_rs2Id;
@@ -309,6 +522,21 @@ wire [31:0] EM_addr;
 wire [63:0] EM_Mdata;
 wire [31:0] EM_CSRdata;
 wire        EM_wbEnable;
+wire [63:0] M_fwdData;
+
+wire [31:0] DMemRAddr;
+wire        DMemREnable;
+wire        DMemRDouble;
+wire [63:0] DMemRData;
+wire        DMemRValid;
+wire        DMemAccess;
+wire        DMemRead;
+wire        DMemWrite;
+wire [31:0] DMemPAddr;
+wire        DMemXlateWait;
+wire        DMemPageFault;
+wire        DMemSbAlmostFull;
+wire        DMemSbEmpty;
 
 /*verilator public_flat_rw_on*/
 wire        E_correctPC;
@@ -316,6 +544,21 @@ wire        E_takeBranch;
 wire        EF_correctPC;
 wire [31:0] EF_PCcorrection;
 wire        aluBusy;
+wire        E_memStall;
+wire        E_longIssue;
+wire        E_longDone;
+wire [5:0]  E_longDoneRdId;
+wire        E_fpPipeDone;
+wire [5:0]  E_fpPipeDoneRdId;
+wire        E_sfence;
+wire [31:0] E_sfenceAddr;
+wire [8:0]  E_sfenceAsid;
+wire        E_sfenceAllAddr;
+wire        E_sfenceAllAsid;
+wire        E_satpWrite;
+wire        E_exc;
+wire [4:0]  E_excCause;
+wire [31:0] E_excTval;
 /*verilator public_off*/
 
 ExecuteUnit execute(
@@ -330,24 +573,66 @@ ExecuteUnit execute(
         .EF_correctPC_o(EF_correctPC),
         .EF_PCcorrection_o(EF_PCcorrection),
         .aluBusy_o(aluBusy),
+        .E_memStall_o(E_memStall),
+        .E_longIssue_o(E_longIssue),
+        .E_longDone_o(E_longDone),
+        .E_longDoneRdId_o(E_longDoneRdId),
+        .E_fenceI_o(E_fenceI),
+        .E_sfence_o(E_sfence),
+        .E_sfenceAddr_o(E_sfenceAddr),
+        .E_sfenceAsid_o(E_sfenceAsid),
+        .E_sfenceAllAddr_o(E_sfenceAllAddr),
+        .E_sfenceAllAsid_o(E_sfenceAllAsid),
+        .E_satpWrite_o(E_satpWrite),
+        .E_exc_o(E_exc),
+        .E_excCause_o(E_excCause),
+        .E_excTval_o(E_excTval),
+        .E_fpPipeDone_o(E_fpPipeDone),
+        .E_fpPipeDoneRdId_o(E_fpPipeDoneRdId),
         .rs1Id_o(rs1Id),
         .rs2Id_o(rs2Id),
         .rs3Id_o(rs3Id),
         .rs1Data_i(rs1Data),
         .rs2Data_i(rs2Data),
-        .rs3Data_i(rs3Data),
+        .fpRs1Data_i(fpRs1Data),
+        .fpRs2Data_i(fpRs2Data),
+        .fpRs3Data_i(fpRs3Data),
+        .fpWrEnable_o(fpWrEnable),
+        .fpWrId_o(fpWrId),
+        .fpWrData_o(fpWrData),
         .csrRAddr_o(csrRAddr),
         .csrRData_i(csrRData),
         .csrFFlagsSet_o(csrFFlagsSet),
         .csrFRM_i(csrFRM),
-        .DMemRAddr_o(DMemRAddr_o),
-        .DMemRData_i(DMemRData_i),
+        .DMemRAddr_o(DMemRAddr),
+        .DMemREnable_o(DMemREnable),
+        .DMemRDouble_o(DMemRDouble),
+        .DMemAccess_o(DMemAccess),
+        .DMemRead_o(DMemRead),
+        .DMemWrite_o(DMemWrite),
+        .DMemPAddr_i(DMemPAddr),
+        .DMemXlateWait_i(DMemXlateWait),
+        .DMemPageFault_i(DMemPageFault),
+        .DMemRData_i(DMemRData),
+        .DMemRValid_i(DMemRValid),
+        .DMemSbAlmostFull_i(DMemSbAlmostFull),
+        .DMemSbEmpty_i(DMemSbEmpty),
+        .IO_memReq_o(IO_memReq_o),
+        .IO_memGrant_i(IO_memGrant_i),
         .MW_wbEnable_i(MW_wbEnable),
         .MW_rdId_i(MW_rdId),
         .MW_wbData_i(MW_wbData),
+        .M_fwdData_i(M_fwdData),
+        .EM2_wbEnable_i(EM2_wbEnable),
+        .EM2_rdId_i(EM2_rdId),
+        .EM2_result_i(EM2_result),
+        .MW2_wbEnable_i(MW2_wbEnable),
+        .MW2_rdId_i(MW2_rdId),
+        .MW2_wbData_i(MW2_wbData),
         .DE_PC_i(DE_PC),
         .DE_instr_i(DE_instr),
         .DE_isRV32C_i(DE_isRV32C),
+        .DE_isFused_i(DE_isFused),
         .DE_nop_i(DE_nop),
         .DE_isLUI_i(DE_isLUI),
         .DE_isAUIPC_i(DE_isAUIPC),
@@ -377,19 +662,27 @@ ExecuteUnit execute(
         .DE_Bimm_i(DE_Bimm),
         .DE_Uimm_i(DE_Uimm),
         .DE_isRV32M_i(DE_isRV32M),
+        .DE_isBitManip_i(DE_isBitManip),
         .DE_isMUL_i(DE_isMUL),
         .DE_isDIV_i(DE_isDIV),
+        .DE_isLongOp_i(DE_isLongOp),
+        .DE_isFPPipe_i(DE_isFPPipe),
         .DE_wbEnable_i(DE_wbEnable),
         .DE_predictBranch_i(DE_predictBranch),
         .DE_predictRA_i(DE_predictRA),
         .EM_PC_o(EM_PC),
         .EM_instr_o(EM_instr),
         .EM_nop_o(EM_nop),
+        .EM_isFused_o(EM_isFused),
         .EM_isLoad_o(EM_isLoad),
         .EM_isStore_o(EM_isStore),
         .EM_isCSR_o(EM_isCSR),
         .EM_isCSRWrite_o(EM_isCSRWrite),
         .EM_isAMO_o(EM_isAMO),
+        .EM_isMUL_o(EM_isMUL),
+        .EM_mulHigh_o(EM_mulHigh),
+        .EM_mulA_o(EM_mulA),
+        .EM_mulB_o(EM_mulB),
         .EM_rdId_o(EM_rdId),
         .EM_rs1Id_o(EM_rs1Id),
         .EM_rs2Id_o(EM_rs2Id),
@@ -415,12 +708,22 @@ wire [5:0]  MW_rdId;
 wire [63:0] MW_wbData;
 wire        MW_wbEnable;
 
+wire [31:0] DMemWAddr;
+wire [63:0] DMemWData;
+wire [4:0]  DMemWMask;
+wire        DMemWAtomic;
+wire [31:0] DMemWatchAddr;
+wire        DMemWatchLost;
+
 MemoryUnit memory(
         .clk_i(clk_i),
         .reset_i(reset_i),
-        .DMemWAddr_o(DMemWAddr_o),
-        .DMemWData_o(DMemWData_o),
-        .DMemWMask_o(DMemWMask_o),
+        .DMemWAddr_o(DMemWAddr),
+        .DMemWData_o(DMemWData),
+        .DMemWMask_o(DMemWMask),
+        .DMemWAtomic_o(DMemWAtomic),
+        .DMemWatchAddr_o(DMemWatchAddr),
+        .DMemWatchLost_i(DMemWatchLost),
         .IO_memAddr_o(IO_memAddr_o),
         .IO_memRData_i(IO_memRData_i),
         .IO_memWData_o(IO_memWData_o),
@@ -429,13 +732,20 @@ MemoryUnit memory(
         .csrWData_o(csrWData),
         .csrWEnable_o(csrWEnable),
         .csrInstStep_o(csrInstStep),
+        .csrInstFused_o(csrInstFused),
         .EM_PC_i(EM_PC),
         .EM_instr_i(EM_instr),
         .EM_nop_i(EM_nop),
+        .EM_isFused_i(EM_isFused),
         .EM_isLoad_i(EM_isLoad),
         .EM_isStore_i(EM_isStore),
         .EM_isCSR_i(EM_isCSR),
+        .EM_isCSRWrite_i(EM_isCSRWrite),
         .EM_isAMO_i(EM_isAMO),
+        .EM_isMUL_i(EM_isMUL),
+        .EM_mulHigh_i(EM_mulHigh),
+        .EM_mulA_i(EM_mulA),
+        .EM_mulB_i(EM_mulB),
         .EM_rdId_i(EM_rdId),
         .EM_rs1Id_i(EM_rs1Id),
         .EM_rs2Id_i(EM_rs2Id),
@@ -448,6 +758,7 @@ MemoryUnit memory(
         .EM_Mdata_i(EM_Mdata),
         .EM_CSRdata_i(EM_CSRdata),
         .EM_wbEnable_i(EM_wbEnable),
+        .M_fwdData_o(M_fwdData),
         .MW_PC_o(MW_PC),
         .MW_instr_o(MW_instr),
         .MW_nop_o(MW_nop),
@@ -455,6 +766,134 @@ MemoryUnit memory(
         .MW_wbData_o(MW_wbData),
         .MW_wbEnable_o(MW_wbEnable)
 );
+
+/******************************************************************************
+ ----------------------------------DATA CACHE----------------------------------
+ ******************************************************************************/
+wire        pfValid;
+wire [31:0] pfAddr;
+wire        pfReady;
+wire        pfIssue;
+wire [2:0]  pfUseful;
+wire        pfLate;
+
+/*-----------------------MMU----------------------*/
+wire [31:0] cacheRAddr;
+wire        cacheREnable;
+wire        cacheRDouble;
+wire        cacheRValid;
+
+MMU mmu(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .csrSatp_i(csrSatp),
+        .csrMStatus_i(csrMStatus),
+        .privilege_i(D_privilege),
+        .fetchPrivilege_i(D_fetchPrivilege),
+        .sfence_i(E_sfence),
+        .sfenceAddr_i(E_sfenceAddr),
+        .sfenceAsid_i(E_sfenceAsid),
+        .sfenceAllAddr_i(E_sfenceAllAddr),
+        .sfenceAllAsid_i(E_sfenceAllAsid),
+        .satpWrite_i(E_satpWrite),
+        .trapTaken_i(csrTrapSetEn),
+        .iAddr_i(IMemAddr),
+        .iFetch_i(F_fetch && IMemValid),
+        .iPageA_o(IMemPageA),
+        .iPageB_o(IMemPageB),
+        .iPageValid_o(IMemPageValid),
+        .iMiss_i(IMemXlateMiss),
+        .iMissAddr_i(IMemXlateAddr),
+        .iFault_o(IMemFault),
+        .dValid_i(DMemAccess),
+        .dRead_i(DMemRead),
+        .dWrite_i(DMemWrite),
+        .dAccept_i(!E_stall),
+        .dAddr_i(DMemRAddr),
+        .dPAddr_o(DMemPAddr),
+        .dWait_o(DMemXlateWait),
+        .dFault_o(DMemPageFault),
+        .rEnable_i(DMemREnable),
+        .rDouble_i(DMemRDouble),
+        .rValid_o(DMemRValid),
+        .cacheRAddr_o(cacheRAddr),
+        .cacheREnable_o(cacheREnable),
+        .cacheRDouble_o(cacheRDouble),
+        .cacheRData_i(DMemRData),
+        .cacheRValid_i(cacheRValid)
+);
+
+DCache dcache(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .rAddr_i(cacheRAddr),
+        .rEnable_i(cacheREnable),
+        .rDouble_i(cacheRDouble),
+        .rData_o(DMemRData),
+        .rValid_o(cacheRValid),
+        .wAddr_i(DMemWAddr),
+        .wData_i(DMemWData),
+        .wMask_i(DMemWMask),
+        .sbAlmostFull_o(DMemSbAlmostFull),
+        .sbEmpty_o(DMemSbEmpty),
+        .pfValid_i(pfValid),
+        .pfAddr_i(pfAddr),
+        .pfReady_o(pfReady),
+        .pfIssue_o(pfIssue),
+        .pfUseful_o(pfUseful),
+        .pfLate_o(pfLate),
+        .snoopValid_i(DMemSnoopValid_i),
+        .snoopAddr_i(DMemSnoopAddr_i),
+        .snoopAck_o(DMemSnoopAck_o),
+        // AMO read in execute until its write is in the store buffer
+        .atomicLock_i((DE_isAMO & !DE_nop & !E_stall) | (EM_isAMO & !EM_nop)),
+        .wAtomic_i(DMemWAtomic),
+        .watchAddr_i(DMemWatchAddr),
+        .watchLost_o(DMemWatchLost),
+        .memReqValid_o(DMemReqValid_o),
+        .memReqReady_i(DMemReqReady_i),
+        .memReqWrite_o(DMemReqWrite_o),
+        .memReqAddr_o(DMemReqAddr_o),
+        .memReqLen_o(DMemReqLen_o),
+        .memWValid_o(DMemWValid_o),
+        .memWReady_i(DMemWReady_i),
+        .memWData_o(DMemWData_o),
+        .memRespValid_i(DMemRespValid_i),
+        .memRespData_i(DMemRespData_i)
+);
+
+// Trained on memory accesses to RAM as they reach the memory unit
+Prefetcher prefetcher(
+        .clk_i(clk_i),
+        .reset_i(reset_i),
+        .trainValid_i((EM_isLoad | EM_isStore | EM_isAMO) & !EM_nop & !EM_addr[22]),
+        .trainPC_i(EM_PC),
+        .trainAddr_i(EM_addr),
+        .pfValid_o(pfValid),
+        .pfAddr_o(pfAddr),
+        .pfReady_i(pfReady),
+        .pfIssue_i(pfIssue),
+        .pfUseful_i(pfUseful),
+        .pfLate_i(pfLate)
+);
+
+/******************************************************************************
+ ------------------------------PERFORMANCE EVENTS------------------------------
+ ******************************************************************************/
+// Events counted by mhpmcounter3+, see CSR_RegFile.v for the event numbers
+assign csrHpmEvents = {
+        7'b0,
+        E_memStall,                                             // 8
+        !IMemValid & F_fetch,                                   // 7
+        csrHazard & !longHazard & !aluBusy,                     // 6
+        aluBusy & !E_memStall,                                  // 5
+        longHazard & !aluBusy,                                  // 4
+        dataHazard & !longHazard & !csrHazard & !aluBusy,       // 3
+        DE_isJALR & E_correctPC & !E_stall,                     // 2
+        DE_isBranch & (E_takeBranch != DE_predictBranch) & !E_stall, // 1
+        1'b0
+} & {16{!reset_i}};
+
 /******************************************************************************
  -------------------------------WRITE BACK UNIT-------------------------------- 
  ******************************************************************************/
@@ -0,0 +1,83 @@
+/*************************************************
+ *File----------RegFileBank.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 07:02:44 UTC
+ ************************************************/
+/* verilator lint_off WIDTH */
+
+module RegFileBank #(
+        parameter WIDTH = 32,
+        parameter READS = 2,
+        parameter ZERO_REG = 1          // Register 0 reads as zero and ignores writes
+)(
+        input  wire                   clk_i,
+        input  wire                   reset_i,
+        // Write Port A
+        input  wire                   wrEnableA_i,
+        input  wire [4:0]             wrIdA_i,
+        input  wire [WIDTH-1:0]       wrDataA_i,
+        // Write Port B
+        input  wire                   wrEnableB_i,
+        input  wire [4:0]             wrIdB_i,
+        input  wire [WIDTH-1:0]       wrDataB_i,
+        // Read Ports, port N at [5*N +: 5] and [WIDTH*N +: WIDTH]
+        input  wire [5*READS-1:0]     readId_i,
+        output wire [WIDTH*READS-1:0] readData_o
+);
+
+/*
+ * 32 registers in distributed RAM (LUTRAM). LUTRAM has one write port, so
+ * each write port gets its own RAM and a live value table (LVT) of flip-flops
+ * remembers which RAM holds the last write of each register. Reads are
+ * asynchronous, every read port reads both RAMs and the LVT picks one.
+ * RAMs can't be reset, so registers not written since reset read as zero.
+ * Both ports never write the same register in the same cycle.
+ */
+
+(* ram_style = "distributed" *)
+reg [WIDTH-1:0] bankA [0:31];
+(* ram_style = "distributed" *)
+reg [WIDTH-1:0] bankB [0:31];
+
+reg [31:0] written = 0;         // Register written since reset
+reg [31:0] lvt = 0;             // Last write went to bank B
+
+wire wrA = wrEnableA_i && !(ZERO_REG && (wrIdA_i == 5'd0));
+wire wrB = wrEnableB_i && !(ZERO_REG && (wrIdB_i == 5'd0));
+
+// No reset on the RAMs so they map to LUTRAM
+always @(posedge clk_i) begin
+        if (wrA)
+                bankA[wrIdA_i] <= wrDataA_i;
+        if (wrB)
+                bankB[wrIdB_i] <= wrDataB_i;
+end
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                written <= 0;
+        end else begin
+                if (wrA) begin
+                        written[wrIdA_i] <= 1'b1;
+                        lvt[wrIdA_i]     <= 1'b0;
+                end
+                if (wrB) begin
+                        written[wrIdB_i] <= 1'b1;
+                        lvt[wrIdB_i]     <= 1'b1;
+                end
+        end
+end
+
+genvar r;
+generate
+        for (r = 0; r < READS; r = r + 1) begin : readPort
+                wire [4:0] id = readId_i[5*r +: 5];
+                assign readData_o[WIDTH*r +: WIDTH] = !written[id] ? {WIDTH{1'b0}} :
+                        lvt[id] ? bankB[id] : bankA[id];
+        end
+endgenerate
+
+endmodule
+/* verilator lint_on WIDTH */
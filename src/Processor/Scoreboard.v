@@ -0,0 +1,72 @@
+/*************************************************
+ *File----------Scoreboard.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Sunday Oct 18, 2026 19:10:42 UTC
+ ************************************************/
+
+module Scoreboard (
+        input  wire        clk_i,
+        input  wire        reset_i,
+        // Long latency op issued. Result for setId_i is pending
+        input  wire        setEnable_i,
+        input  wire [5:0]  setId_i,
+        // Long latency op written back. Result for clearId_i is in the pipeline
+        input  wire        clearEnable_i,
+        input  wire [5:0]  clearId_i,
+        // FP pipeline op in its last stage. Result for clear2Id_i is forwarded next cycle
+        input  wire        clear2Enable_i,
+        input  wire [5:0]  clear2Id_i,
+        // Lookup
+        input  wire [5:0]  rs1Id_i,
+        input  wire [5:0]  rs2Id_i,
+        input  wire [5:0]  rs3Id_i,
+        input  wire [5:0]  rdId_i,
+        output wire        rs1Pending_o,
+        output wire        rs2Pending_o,
+        output wire        rs3Pending_o,
+        output wire        rdPending_o,
+        // Lookup for the second issue lane (integer registers)
+        input  wire [5:0]  rs1Id2_i,
+        input  wire [5:0]  rs2Id2_i,
+        input  wire [5:0]  rdId2_i,
+        output wire        rs1Pending2_o,
+        output wire        rs2Pending2_o,
+        output wire        rdPending2_o
+);
+
+/*
+ * One pending bit per register. Registers 0-31 are the integer registers and
+ * 32-63 are the floating point registers. x0 is never set.
+ * A register being cleared this cycle is not pending since its result will be
+ * in the EM register or the FP pipeline result register and can be forwarded.
+ */
+/*verilator public_flat_rw_on*/
+reg  [63:0] pending = 64'b0;
+/*verilator public_off*/
+
+wire [63:0] setMask   = (setEnable_i && setId_i != 6'b0) ? (64'b1 << setId_i) : 64'b0;
+wire [63:0] clearMask =
+        (clearEnable_i  ? (64'b1 << clearId_i)  : 64'b0) |
+        (clear2Enable_i ? (64'b1 << clear2Id_i) : 64'b0);
+wire [63:0] pendingNow = pending & ~clearMask;
+
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                pending <= 64'b0;
+        end else begin
+                pending <= pendingNow | setMask;
+        end
+end
+
+assign rs1Pending_o = pendingNow[rs1Id_i];
+assign rs2Pending_o = pendingNow[rs2Id_i];
+assign rs3Pending_o = pendingNow[rs3Id_i];
+assign rdPending_o  = pendingNow[rdId_i];
+
+assign rs1Pending2_o = pendingNow[rs1Id2_i];
+assign rs2Pending2_o = pendingNow[rs2Id2_i];
+assign rdPending2_o  = pendingNow[rdId2_i];
+
+endmodule
@@ -0,0 +1,111 @@
+/*************************************************
+ *File----------TLB.v
+ *Project-------Risc-V-FPGA
+ *License-------GNU GPL-3.0
+ *Author--------Justin Kachele
+ *Created-------Monday Oct 19, 2026 04:12:37 UTC
+ ************************************************/
+/* verilator lint_off WIDTH */
+
+module TLB #(
+        parameter ENTRIES = 8           // Fully associative
+)(
+        input  wire        clk_i,
+        input  wire        reset_i,
+        input  wire [8:0]  asid_i,          // satp.ASID
+        // Lookup
+        input  wire [19:0] vpnA_i,
+        output wire        hitA_o,
+        output wire [19:0] ppnA_o,
+        output wire [7:0]  flagsA_o,        // PTE[7:0] {D, A, G, U, X, W, R, V}
+        input  wire [19:0] vpnB_i,
+        output wire        hitB_o,
+        output wire [19:0] ppnB_o,
+        output wire [7:0]  flagsB_o,
+        // Fill (page table walker)
+        input  wire        fill_i,
+        input  wire [19:0] fillVpn_i,
+        input  wire [19:0] fillPpn_i,
+        input  wire [7:0]  fillFlags_i,
+        input  wire        fillMega_i,      // 4 MiB megapage
+        // Flush (SFENCE.VMA)
+        input  wire        flush_i,
+        input  wire [19:0] flushVpn_i,
+        input  wire [8:0]  flushAsid_i,
+        input  wire        flushAllVpn_i,   // rs1 = x0
+        input  wire        flushAllAsid_i   // rs2 = x0
+);
+
+/*
+ * Sv32 translations. An entry matches when its ASID is the current one or it
+ * is global. Megapage entries only compare VPN[1] and take VPN[0] from the
+ * address. Two lookup ports so fetch can translate the page after the PC too.
+ * Permissions are checked by the MMU on the returned PTE flags.
+ */
+
+localparam IDX_BITS = (ENTRIES > 1) ? $clog2(ENTRIES) : 1;
+
+reg [ENTRIES-1:0]  valid = 0;
+reg [ENTRIES-1:0]  mega;
+reg [19:0]         vpn   [0:ENTRIES-1];
+reg [19:0]         ppn   [0:ENTRIES-1];
+reg [8:0]          asid  [0:ENTRIES-1];
+reg [7:0]          flags [0:ENTRIES-1];
+reg [IDX_BITS-1:0] victim = 0;          // Round robin replacement
+
+// {hit, entry} for a virtual page number
+function [IDX_BITS:0] lookup;
+        input [19:0] page;
+        integer e;
+        begin
+                lookup = 0;
+                for (e = 0; e < ENTRIES; e = e + 1) begin
+                        if (valid[e] && (flags[e][5] || (asid[e] == asid_i)) &&
+                            (vpn[e][19:10] == page[19:10]) &&
+                            (mega[e] || (vpn[e][9:0] == page[9:0])))
+                                lookup = {1'b1, e[IDX_BITS-1:0]};
+                end
+        end
+endfunction
+
+wire [IDX_BITS:0] lookupA = lookup(vpnA_i);
+wire [IDX_BITS:0] lookupB = lookup(vpnB_i);
+wire [IDX_BITS-1:0] idxA = lookupA[IDX_BITS-1:0];
+wire [IDX_BITS-1:0] idxB = lookupB[IDX_BITS-1:0];
+
+assign hitA_o   = lookupA[IDX_BITS];
+assign ppnA_o   = {ppn[idxA][19:10], mega[idxA] ? vpnA_i[9:0] : ppn[idxA][9:0]};
+assign flagsA_o = flags[idxA];
+assign hitB_o   = lookupB[IDX_BITS];
+assign ppnB_o   = {ppn[idxB][19:10], mega[idxB] ? vpnB_i[9:0] : ppn[idxB][9:0]};
+assign flagsB_o = flags[idxB];
+
+integer f;
+always @(posedge clk_i) begin
+        if (reset_i) begin
+                valid  <= 0;
+                victim <= 0;
+        end else begin
+                if (flush_i) begin
+                        for (f = 0; f < ENTRIES; f = f + 1) begin
+                                if ((flushAllVpn_i || ((vpn[f][19:10] == flushVpn_i[19:10]) &&
+                                                (mega[f] || (vpn[f][9:0] == flushVpn_i[9:0])))) &&
+                                    (flushAllAsid_i || (!flags[f][5] && (asid[f] == flushAsid_i))))
+                                        valid[f] <= 1'b0;
+                        end
+                end
+
+                if (fill_i) begin
+                        valid[victim] <= 1'b1;
+                        mega[victim]  <= fillMega_i;
+                        vpn[victim]   <= fillVpn_i;
+                        ppn[victim]   <= fillPpn_i;
+                        asid[victim]  <= asid_i;
+                        flags[victim] <= fillFlags_i;
+                        victim <= (victim == ENTRIES - 1) ? 0 : victim + 1;
+                end
+        end
+end
+
+endmodule
+/* verilator lint_on WIDTH */
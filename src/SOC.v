@@ -21,13 +21,22 @@ wire reset;
 /*verilator public_off*/
 
 //Memory
-wire [31:0] IMemAddr;
-wire [31:0] IMemData;
-wire [31:0] DMemRAddr;
-wire [63:0] DMemRData;
-wire [31:0] DMemWAddr;
-wire [63:0] DMemWData;
-wire [4:0]  DMemWMask;
+wire        IMemReqValid;
+wire        IMemReqReady;
+wire [31:0] IMemReqAddr;
+wire [7:0]  IMemReqLen;
+wire        IMemRespValid;
+wire [31:0] IMemRespData;
+wire        DMemReqValid;
+wire        DMemReqReady;
+wire        DMemReqWrite;
+wire [31:0] DMemReqAddr;
+wire [7:0]  DMemReqLen;
+wire        DMemWValid;
+wire        DMemWReady;
+wire [31:0] DMemWData;
+wire        DMemRespValid;
+wire [31:0] DMemRespData;
 
 // IO
 wire [31:0] IO_memAddr;
@@ -35,34 +44,313 @@ wire [31:0] IO_memRData;
 wire [31:0] IO_memWData;
 wire        IO_memWr;
 
+// Machine timer and software interrupts and mtime from the CLINT
+`ifdef DUALCORE
+localparam HARTS = 2;
+`else
+localparam HARTS = 1;
+`endif
+wire [HARTS-1:0] timerIrq;
+wire [HARTS-1:0] softIrq;
+wire [63:0]      mtime;
+
+`ifdef DUALCORE
+/*
+ * Two harts share the memory ports through an arbiter each. The data arbiter
+ * snoops the other data cache before every refill, which keeps the caches
+ * coherent and makes AMOs and LR/SC atomic across harts.
+ * The IO arbiter gives the IO port to one hart at a time, the other waits in
+ * execute.
+ */
+// Hart 0
+wire        I0ReqValid;
+wire        I0ReqReady;
+wire [31:0] I0ReqAddr;
+wire [7:0]  I0ReqLen;
+wire        I0RespValid;
+wire [31:0] I0RespData;
+wire        D0ReqValid;
+wire        D0ReqReady;
+wire        D0ReqWrite;
+wire [31:0] D0ReqAddr;
+wire [7:0]  D0ReqLen;
+wire        D0WValid;
+wire        D0WReady;
+wire [31:0] D0WData;
+wire        D0RespValid;
+wire [31:0] D0RespData;
+wire        D0SnoopValid;
+wire [31:0] D0SnoopAddr;
+wire        D0SnoopAck;
+wire [31:0] IO0_memAddr;
+wire [31:0] IO0_memRData;
+wire [31:0] IO0_memWData;
+wire        IO0_memWr;
+wire        IO0_memReq;
+wire        IO0_memGrant;
+
+// Hart 1
+wire        I1ReqValid;
+wire        I1ReqReady;
+wire [31:0] I1ReqAddr;
+wire [7:0]  I1ReqLen;
+wire        I1RespValid;
+wire [31:0] I1RespData;
+wire        D1ReqValid;
+wire        D1ReqReady;
+wire        D1ReqWrite;
+wire [31:0] D1ReqAddr;
+wire [7:0]  D1ReqLen;
+wire        D1WValid;
+wire        D1WReady;
+wire [31:0] D1WData;
+wire        D1RespValid;
+wire [31:0] D1RespData;
+wire        D1SnoopValid;
+wire [31:0] D1SnoopAddr;
+wire        D1SnoopAck;
+wire [31:0] IO1_memAddr;
+wire [31:0] IO1_memRData;
+wire [31:0] IO1_memWData;
+wire        IO1_memWr;
+wire        IO1_memReq;
+wire        IO1_memGrant;
+
+IOArbiter ioarb(
+        .clk_i(clk),
+        .reset_i(reset),
+        .h0Req_i(IO0_memReq),
+        .h0Grant_o(IO0_memGrant),
+        .h0Addr_i(IO0_memAddr),
+        .h0RData_o(IO0_memRData),
+        .h0WData_i(IO0_memWData),
+        .h0Wr_i(IO0_memWr),
+        .h1Req_i(IO1_memReq),
+        .h1Grant_o(IO1_memGrant),
+        .h1Addr_i(IO1_memAddr),
+        .h1RData_o(IO1_memRData),
+        .h1WData_i(IO1_memWData),
+        .h1Wr_i(IO1_memWr),
+        .IO_memAddr_o(IO_memAddr),
+        .IO_memRData_i(IO_memRData),
+        .IO_memWData_o(IO_memWData),
+        .IO_memWr_o(IO_memWr)
+);
+
+Processor #(
+        .HARTID(0)
+)CPU(
+        .clk_i(clk),
+        .reset_i(reset),
+        .IMemReqValid_o(I0ReqValid),
+        .IMemReqReady_i(I0ReqReady),
+        .IMemReqAddr_o(I0ReqAddr),
+        .IMemReqLen_o(I0ReqLen),
+        .IMemRespValid_i(I0RespValid),
+        .IMemRespData_i(I0RespData),
+        .DMemReqValid_o(D0ReqValid),
+        .DMemReqReady_i(D0ReqReady),
+        .DMemReqWrite_o(D0ReqWrite),
+        .DMemReqAddr_o(D0ReqAddr),
+        .DMemReqLen_o(D0ReqLen),
+        .DMemWValid_o(D0WValid),
+        .DMemWReady_i(D0WReady),
+        .DMemWData_o(D0WData),
+        .DMemRespValid_i(D0RespValid),
+        .DMemRespData_i(D0RespData),
+        .DMemSnoopValid_i(D0SnoopValid),
+        .DMemSnoopAddr_i(D0SnoopAddr),
+        .DMemSnoopAck_o(D0SnoopAck),
+        .IO_memAddr_o(IO0_memAddr),
+        .IO_memRData_i(IO0_memRData),
+        .IO_memWData_o(IO0_memWData),
+        .IO_memWr_o(IO0_memWr),
+        .IO_memReq_o(IO0_memReq),
+        .IO_memGrant_i(IO0_memGrant),
+        .timerIrq_i(timerIrq[0]),
+        .softIrq_i(softIrq[0]),
+        .mtime_i(mtime)
+);
+
+Processor #(
+        .HARTID(1)
+)CPU1(
+        .clk_i(clk),
+        .reset_i(reset),
+        .IMemReqValid_o(I1ReqValid),
+        .IMemReqReady_i(I1ReqReady),
+        .IMemReqAddr_o(I1ReqAddr),
+        .IMemReqLen_o(I1ReqLen),
+        .IMemRespValid_i(I1RespValid),
+        .IMemRespData_i(I1RespData),
+        .DMemReqValid_o(D1ReqValid),
+        .DMemReqReady_i(D1ReqReady),
+        .DMemReqWrite_o(D1ReqWrite),
+        .DMemReqAddr_o(D1ReqAddr),
+        .DMemReqLen_o(D1ReqLen),
+        .DMemWValid_o(D1WValid),
+        .DMemWReady_i(D1WReady),
+        .DMemWData_o(D1WData),
+        .DMemRespValid_i(D1RespValid),
+        .DMemRespData_i(D1RespData),
+        .DMemSnoopValid_i(D1SnoopValid),
+        .DMemSnoopAddr_i(D1SnoopAddr),
+        .DMemSnoopAck_o(D1SnoopAck),
+        .IO_memAddr_o(IO1_memAddr),
+        .IO_memRData_i(IO1_memRData),
+        .IO_memWData_o(IO1_memWData),
+        .IO_memWr_o(IO1_memWr),
+        .IO_memReq_o(IO1_memReq),
+        .IO_memGrant_i(IO1_memGrant),
+        .timerIrq_i(timerIrq[1]),
+        .softIrq_i(softIrq[1]),
+        .mtime_i(mtime)
+);
+
+// Instruction refills are read only and need no snoop
+MemArbiter #(
+        .SNOOP(0)
+)iarb(
+        .clk_i(clk),
+        .reset_i(reset),
+        .m0ReqValid_i(I0ReqValid),
+        .m0ReqReady_o(I0ReqReady),
+        .m0ReqWrite_i(1'b0),
+        .m0ReqAddr_i(I0ReqAddr),
+        .m0ReqLen_i(I0ReqLen),
+        .m0WValid_i(1'b0),
+        .m0WReady_o(),
+        .m0WData_i(32'b0),
+        .m0RespValid_o(I0RespValid),
+        .m0RespData_o(I0RespData),
+        .m0SnoopValid_o(),
+        .m0SnoopAddr_o(),
+        .m0SnoopAck_i(1'b0),
+        .m1ReqValid_i(I1ReqValid),
+        .m1ReqReady_o(I1ReqReady),
+        .m1ReqWrite_i(1'b0),
+        .m1ReqAddr_i(I1ReqAddr),
+        .m1ReqLen_i(I1ReqLen),
+        .m1WValid_i(1'b0),
+        .m1WReady_o(),
+        .m1WData_i(32'b0),
+        .m1RespValid_o(I1RespValid),
+        .m1RespData_o(I1RespData),
+        .m1SnoopValid_o(),
+        .m1SnoopAddr_o(),
+        .m1SnoopAck_i(1'b0),
+        .memReqValid_o(IMemReqValid),
+        .memReqReady_i(IMemReqReady),
+        .memReqWrite_o(),
+        .memReqAddr_o(IMemReqAddr),
+        .memReqLen_o(IMemReqLen),
+        .memWValid_o(),
+        .memWReady_i(1'b0),
+        .memWData_o(),
+        .memRespValid_i(IMemRespValid),
+        .memRespData_i(IMemRespData)
+);
+
+MemArbiter #(
+        .SNOOP(1)
+)darb(
+        .clk_i(clk),
+        .reset_i(reset),
+        .m0ReqValid_i(D0ReqValid),
+        .m0ReqReady_o(D0ReqReady),
+        .m0ReqWrite_i(D0ReqWrite),
+        .m0ReqAddr_i(D0ReqAddr),
+        .m0ReqLen_i(D0ReqLen),
+        .m0WValid_i(D0WValid),
+        .m0WReady_o(D0WReady),
+        .m0WData_i(D0WData),
+        .m0RespValid_o(D0RespValid),
+        .m0RespData_o(D0RespData),
+        .m0SnoopValid_o(D0SnoopValid),
+        .m0SnoopAddr_o(D0SnoopAddr),
+        .m0SnoopAck_i(D0SnoopAck),
+        .m1ReqValid_i(D1ReqValid),
+        .m1ReqReady_o(D1ReqReady),
+        .m1ReqWrite_i(D1ReqWrite),
+        .m1ReqAddr_i(D1ReqAddr),
+        .m1ReqLen_i(D1ReqLen),
+        .m1WValid_i(D1WValid),
+        .m1WReady_o(D1WReady),
+        .m1WData_i(D1WData),
+        .m1RespValid_o(D1RespValid),
+        .m1RespData_o(D1RespData),
+        .m1SnoopValid_o(D1SnoopValid),
+        .m1SnoopAddr_o(D1SnoopAddr),
+        .m1SnoopAck_i(D1SnoopAck),
+        .memReqValid_o(DMemReqValid),
+        .memReqReady_i(DMemReqReady),
+        .memReqWrite_o(DMemReqWrite),
+        .memReqAddr_o(DMemReqAddr),
+        .memReqLen_o(DMemReqLen),
+        .memWValid_o(DMemWValid),
+        .memWReady_i(DMemWReady),
+        .memWData_o(DMemWData),
+        .memRespValid_i(DMemRespValid),
+        .memRespData_i(DMemRespData)
+);
+`else
 Processor CPU(
         .clk_i(clk),
         .reset_i(reset),
-        .IMemAddr_o(IMemAddr),
-        .IMemData_i(IMemData),
-        .DMemRAddr_o(DMemRAddr),
-        .DMemRData_i(DMemRData),
-        .DMemWAddr_o(DMemWAddr),
+        .IMemReqValid_o(IMemReqValid),
+        .IMemReqReady_i(IMemReqReady),
+        .IMemReqAddr_o(IMemReqAddr),
+        .IMemReqLen_o(IMemReqLen),
+        .IMemRespValid_i(IMemRespValid),
+        .IMemRespData_i(IMemRespData),
+        .DMemReqValid_o(DMemReqValid),
+        .DMemReqReady_i(DMemReqReady),
+        .DMemReqWrite_o(DMemReqWrite),
+        .DMemReqAddr_o(DMemReqAddr),
+        .DMemReqLen_o(DMemReqLen),
+        .DMemWValid_o(DMemWValid),
+        .DMemWReady_i(DMemWReady),
         .DMemWData_o(DMemWData),
-        .DMemWMask_o(DMemWMask),
+        .DMemRespValid_i(DMemRespValid),
+        .DMemRespData_i(DMemRespData),
+        .DMemSnoopValid_i(1'b0),
+        .DMemSnoopAddr_i(32'b0),
+        .DMemSnoopAck_o(),
         .IO_memAddr_o(IO_memAddr),
         .IO_memRData_i(IO_memRData),
         .IO_memWData_o(IO_memWData),
-        .IO_memWr_o(IO_memWr)
+        .IO_memWr_o(IO_memWr),
+        .IO_memReq_o(),
+        .IO_memGrant_i(1'b1),
+        .timerIrq_i(timerIrq[0]),
+        .softIrq_i(softIrq[0]),
+        .mtime_i(mtime)
 );
+`endif
 
 Memory mem(
         .clk_i(clk),
-        .IMemAddr_i(IMemAddr),
-        .IMemData_o(IMemData),
-        .DMemRAddr_i(DMemRAddr),
-        .DMemRData_o(DMemRData),
-        .DMemWAddr_i(DMemWAddr),
+        .IMemReqValid_i(IMemReqValid),
+        .IMemReqReady_o(IMemReqReady),
+        .IMemReqAddr_i(IMemReqAddr),
+        .IMemReqLen_i(IMemReqLen),
+        .IMemRespValid_o(IMemRespValid),
+        .IMemRespData_o(IMemRespData),
+        .DMemReqValid_i(DMemReqValid),
+        .DMemReqReady_o(DMemReqReady),
+        .DMemReqWrite_i(DMemReqWrite),
+        .DMemReqAddr_i(DMemReqAddr),
+        .DMemReqLen_i(DMemReqLen),
+        .DMemWValid_i(DMemWValid),
+        .DMemWReady_o(DMemWReady),
         .DMemWData_i(DMemWData),
-        .DMemWMask_i(DMemWMask)
+        .DMemRespValid_o(DMemRespValid),
+        .DMemRespData_o(DMemRespData)
 );
 
-IO io(
+IO #(
+        .HARTS(HARTS)
+)io(
         .clk_i(clk),
         .reset_i(reset),
         .IO_memAddr_i(IO_memAddr),
@@ -70,7 +358,10 @@ IO io(
         .IO_memWData_i(IO_memWData),
         .IO_memWr_i(IO_memWr),
         .leds_o(LEDS),
-        .txd_o(TXD)
+        .txd_o(TXD),
+        .timerIrq_o(timerIrq),
+        .softIrq_o(softIrq),
+        .mtime_o(mtime)
 );
 
 Clockworks #(
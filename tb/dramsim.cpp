@@ -0,0 +1,215 @@
+/*************************************************
+ *File----------dramsim.cpp
+ *Project-------Risc-V-FPGA
+ *Author--------Justin Kachele
+ *Created-------Sunday Oct 18, 2026 23:41:52 UTC
+ *License-------GNU GPL-3.0
+ ************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "dramsim.h"
+
+typedef uint64_t u64;
+
+struct DRAMBank {
+        int64_t openRow;        // -1 when precharged
+        u64 ready;              // Cycle the bank can take a new command
+        u64 activated;          // Cycle of the last activate (tRAS)
+};
+
+struct DRAMPortStats {
+        u64 reads;
+        u64 writes;
+        u64 words;
+        u64 latency;            // Sum of first word latencies
+        u64 maxLatency;
+        u64 hist[DRAM_HIST_BUCKETS];
+};
+
+static DRAMConfig cfg;
+static DRAMBank *bank = NULL;
+static u64 busFree = 0;         // Cycle the data bus is free
+static u64 nextRefresh = 0;
+static u64 lastCycle = 0;       // Extends the 32 bit cycle from Memory.v
+
+// Statistics
+static u64 rowHits = 0;
+static u64 rowMisses = 0;
+static u64 rowConflicts = 0;
+static u64 bankWaitCycles = 0;  // Cycles waiting for a busy bank
+static u64 busWaitCycles = 0;   // Cycles waiting for the data bus
+static u64 busBusyCycles = 0;
+static u64 refreshes = 0;
+static DRAMPortStats stats[DRAM_PORTS];
+
+static int envInt(const char *name, int def) {
+        const char *s = getenv(name);
+        return s ? atoi(s) : def;
+}
+
+static void dramInit(void) {
+        cfg.banks         = envInt("DRAM_BANKS", 8);
+        cfg.rowBytes      = envInt("DRAM_ROW_BYTES", 2048);
+        cfg.bytesPerCycle = envInt("DRAM_BYTES_PER_CYCLE", 16);
+        cfg.tCTRL         = envInt("DRAM_TCTRL", 8);
+        cfg.tRCD          = envInt("DRAM_TRCD", 2);
+        cfg.tCAS          = envInt("DRAM_TCAS", 2);
+        cfg.tCWL          = envInt("DRAM_TCWL", 1);
+        cfg.tRP           = envInt("DRAM_TRP", 2);
+        cfg.tRAS          = envInt("DRAM_TRAS", 4);
+        cfg.tWR           = envInt("DRAM_TWR", 2);
+        cfg.tREFI         = envInt("DRAM_TREFI", 780);
+        cfg.tRFC          = envInt("DRAM_TRFC", 26);
+
+        if (cfg.banks < 1)
+                cfg.banks = 1;
+        if (cfg.rowBytes < 4)
+                cfg.rowBytes = 4;
+        if (cfg.bytesPerCycle < 1)
+                cfg.bytesPerCycle = 1;
+
+        bank = new DRAMBank[cfg.banks];
+        for (int i = 0; i < cfg.banks; i++) {
+                bank[i].openRow = -1;
+                bank[i].ready = 0;
+                bank[i].activated = 0;
+        }
+        nextRefresh = cfg.tREFI;
+}
+
+// Issue every refresh due before cycle t. Refresh closes all rows
+static void dramRefresh(u64 t) {
+        if (cfg.tREFI <= 0)
+                return;
+        while (nextRefresh <= t) {
+                u64 end = nextRefresh + cfg.tRFC;
+                for (int i = 0; i < cfg.banks; i++) {
+                        bank[i].openRow = -1;
+                        if (bank[i].ready < end)
+                                bank[i].ready = end;
+                }
+                if (busFree < end)
+                        busFree = end;
+                nextRefresh += cfg.tREFI;
+                refreshes++;
+        }
+}
+
+static u64 max64(u64 a, u64 b) {
+        return a > b ? a : b;
+}
+
+extern "C" int dram_access(int cycle, int port, int write, int addr, int len) {
+        if (bank == NULL)
+                dramInit();
+
+        // Extend the cycle counter past 32 bits
+        u64 now = (lastCycle & ~0xFFFFFFFFull) | (uint32_t)cycle;
+        if (now < lastCycle)
+                now += 1ull << 32;
+        lastCycle = now;
+
+        uint32_t a = (uint32_t)addr;
+        int      b = (a / cfg.rowBytes) % cfg.banks;
+        int64_t  row = a / ((uint32_t)cfg.rowBytes * cfg.banks);
+        DRAMBank *bk = &bank[b];
+
+        u64 t = now + cfg.tCTRL;
+        dramRefresh(t);
+
+        // Wait for the bank to finish its last burst
+        if (bk->ready > t) {
+                bankWaitCycles += bk->ready - t;
+                t = bk->ready;
+        }
+
+        if (bk->openRow == row) {
+                rowHits++;
+        } else {
+                if (bk->openRow < 0) {
+                        rowMisses++;
+                } else {
+                        rowConflicts++;
+                        t = max64(t, bk->activated + cfg.tRAS) + cfg.tRP;
+                }
+                bk->activated = t;
+                bk->openRow = row;
+                t += cfg.tRCD;
+        }
+        t += write ? cfg.tCWL : cfg.tCAS;
+
+        // Data burst on the shared bus
+        if (busFree > t) {
+                busWaitCycles += busFree - t;
+                t = busFree;
+        }
+        int burst = (len * 4 + cfg.bytesPerCycle - 1) / cfg.bytesPerCycle;
+        busFree = t + burst;
+        busBusyCycles += burst;
+        bk->ready = busFree + (write ? cfg.tWR : 0);
+
+        // Memory.v returns one word per cycle, so the first word is held back
+        // until the bus can deliver the rest of the burst at that rate
+        u64 first = t - now;
+        if (busFree - now > (u64)len && busFree - now - len > first)
+                first = busFree - now - len;
+        if (first < 1)
+                first = 1;
+
+        DRAMPortStats *s = &stats[port < DRAM_PORTS ? port : DRAM_PORTS - 1];
+        if (write)
+                s->writes++;
+        else
+                s->reads++;
+        s->words += len;
+        s->latency += first;
+        if (first > s->maxLatency)
+                s->maxLatency = first;
+        u64 bucket = first / DRAM_HIST_WIDTH;
+        s->hist[bucket < DRAM_HIST_BUCKETS ? bucket : DRAM_HIST_BUCKETS - 1]++;
+
+        return (int)first;
+}
+
+void dram_report(uint64_t cycles) {
+        static const char *portName[DRAM_PORTS] = {"Instr", "Data"};
+
+        if (bank == NULL)
+                return;
+
+        u64 accesses = rowHits + rowMisses + rowConflicts;
+
+        printf("\nDRAM report\n");
+        printf("----------------------------\n");
+        printf("Accesses   = %lu\n", accesses);
+        printf("Row hits   = %3.3f\%%\n", rowHits*100.0/accesses);
+        printf("Row misses = %3.3f\%%\n", rowMisses*100.0/accesses);
+        printf("Conflicts  = %3.3f\%%\n", rowConflicts*100.0/accesses);
+        printf("Bank wait  = %lu cycles\n", bankWaitCycles);
+        printf("Bus wait   = %lu cycles\n", busWaitCycles);
+        printf("Refreshes  = %lu\n", refreshes);
+        printf("Bus util.  = %3.3f\%%\n", busBusyCycles*100.0/cycles);
+        for (int p = 0; p < DRAM_PORTS; p++) {
+                DRAMPortStats *s = &stats[p];
+                u64 n = s->reads + s->writes;
+                if (n == 0)
+                        continue;
+                printf("%s port: %lu reads, %lu writes, %3.3f bytes/cycle\n",
+                                portName[p], s->reads, s->writes,
+                                s->words*4.0/cycles);
+                printf("  Avg latency = %3.3f, max = %lu\n",
+                                s->latency*1.0/n, s->maxLatency);
+                printf("  Latency | Count\n");
+                for (int i = 0; i < DRAM_HIST_BUCKETS; i++) {
+                        if (s->hist[i] == 0)
+                                continue;
+                        if (i == DRAM_HIST_BUCKETS - 1)
+                                printf("  %5d+  | %lu\n",
+                                                i*DRAM_HIST_WIDTH, s->hist[i]);
+                        else
+                                printf("  %3d-%-3d | %lu\n", i*DRAM_HIST_WIDTH,
+                                                (i+1)*DRAM_HIST_WIDTH-1, s->hist[i]);
+                }
+        }
+}
@@ -0,0 +1,59 @@
+/*************************************************
+ *File----------dramsim.h
+ *Project-------Risc-V-FPGA
+ *Author--------Justin Kachele
+ *Created-------Sunday Oct 18, 2026 23:41:17 UTC
+ *License-------GNU GPL-3.0
+ ************************************************/
+#ifndef DRAMSIM_H
+#define DRAMSIM_H
+
+#include <cstdint>
+
+/*
+ * DRAM timing model used by Memory.v in BENCH builds.
+ * Memory.v keeps the memory contents and calls dram_access() through DPI-C
+ * when it accepts a burst. The model returns the number of cycles until the
+ * first word and tracks the bank and data bus state the burst leaves behind.
+ *
+ * Addresses map to row:bank:column with an open page policy. An access can be
+ * a row hit (CAS only), a row miss on a precharged bank (RAS + CAS) or a
+ * row conflict (precharge + RAS + CAS). A bank that is still busy with an
+ * earlier burst delays the next one, and all rows are closed by a periodic
+ * refresh that blocks the device for tRFC.
+ *
+ * All timings are in core clock cycles. The defaults approximate the DDR3
+ * on the Arty-A7 behind the MIG at 100MHz. Each one can be changed with an
+ * environment variable of the same name, e.g. DRAM_TCAS=3.
+ */
+
+struct DRAMConfig {
+        int banks;              // DRAM_BANKS
+        int rowBytes;           // DRAM_ROW_BYTES: Bytes per row in one bank
+        int bytesPerCycle;      // DRAM_BYTES_PER_CYCLE: Data bus bandwidth
+        int tCTRL;              // DRAM_TCTRL: Controller/PHY latency
+        int tRCD;               // DRAM_TRCD: Activate to read/write
+        int tCAS;               // DRAM_TCAS: Read to data
+        int tCWL;               // DRAM_TCWL: Write to data
+        int tRP;                // DRAM_TRP: Precharge to activate
+        int tRAS;               // DRAM_TRAS: Activate to precharge
+        int tWR;                // DRAM_TWR: Write recovery before precharge
+        int tREFI;              // DRAM_TREFI: Refresh interval (0 disables)
+        int tRFC;               // DRAM_TRFC: Refresh duration
+};
+
+// Memory.v ports that share the DRAM
+#define DRAM_PORT_I             0
+#define DRAM_PORT_D             1
+#define DRAM_PORTS              2
+
+#define DRAM_HIST_BUCKETS       16
+#define DRAM_HIST_WIDTH         4       // Cycles per histogram bucket
+
+// Called through DPI-C from Memory.v
+extern "C" int dram_access(int cycle, int port, int write, int addr, int len);
+
+// Print bandwidth, row buffer and latency statistics for the run
+void dram_report(uint64_t cycles);
+
+#endif
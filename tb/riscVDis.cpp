@@ -95,3 +95,68 @@ bool riscV_isAMO(u32 instruction) {
         u32 opcode = opCode(instruction);
         return opcode == 0b0101111;
 }
+
+int riscV_pairClass(u32 instruction) {
+        if (riscV_isLUI(instruction))
+                return PAIR_LUI;
+        if (riscV_isAUIPC(instruction))
+                return PAIR_AUIPC;
+        if (riscV_isALUI(instruction)) {
+                if (funct3(instruction) == 0b000)
+                        return PAIR_ADDI;
+                if (funct3(instruction) == 0b001 && funct7(instruction) == 0)
+                        return PAIR_SLLI;
+                return PAIR_ALUI;
+        }
+        if (riscV_isRV32M(instruction))
+                return PAIR_MULDIV;
+        if (riscV_isALUR(instruction)) {
+                if (funct3(instruction) == 0b000 && funct7(instruction) == 0)
+                        return PAIR_ADD;
+                return PAIR_ALUR;
+        }
+        if (riscV_isLoad(instruction))
+                return PAIR_LOAD;
+        if (riscV_isStore(instruction))
+                return PAIR_STORE;
+        if (riscV_isBranch(instruction))
+                return PAIR_BRANCH;
+        if (riscV_isJAL(instruction))
+                return PAIR_JAL;
+        if (riscV_isJALR(instruction))
+                return PAIR_JALR;
+        if (riscV_isFPU(instruction))
+                return PAIR_FPU;
+        if (riscV_isAMO(instruction))
+                return PAIR_AMO;
+        return PAIR_OTHER;
+}
+
+const char *riscV_pairClassName(int pairClass) {
+        static const char *names[PAIR_CLASSES] = {
+                "lui", "auipc", "addi", "slli", "alu-imm", "add", "alu-reg",
+                "mul/div", "load", "store", "branch", "jal", "jalr", "fpu",
+                "amo", "other"
+        };
+        return names[pairClass];
+}
+
+u32 riscV_rd(u32 instruction) {
+        if (riscV_isStore(instruction) || riscV_isBranch(instruction))
+                return 0;
+        return (instruction >> 7) & 0b11111;
+}
+
+// Integer source registers only
+bool riscV_readsReg(u32 instruction, u32 reg) {
+        u32 rs1 = (instruction >> 15) & 0b11111;
+        u32 rs2 = (instruction >> 20) & 0b11111;
+        if (reg == 0 || riscV_isLUI(instruction) || riscV_isAUIPC(instruction) ||
+                        riscV_isJAL(instruction) || riscV_isFPU(instruction))
+                return false;
+        if (rs1 == reg)
+                return true;
+        return (riscV_isALUR(instruction) || riscV_isStore(instruction) ||
+                        riscV_isBranch(instruction) || riscV_isAMO(instruction)) &&
+                (rs2 == reg);
+}
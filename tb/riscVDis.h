@@ -30,5 +30,16 @@ bool riscV_isDiv(u32 instruction);
 bool riscV_isFPU(u32 instruction);
 bool riscV_isAMO(u32 instruction);
 
+// Instruction classes for the instruction pair statistics
+enum {
+        PAIR_LUI, PAIR_AUIPC, PAIR_ADDI, PAIR_SLLI, PAIR_ALUI, PAIR_ADD,
+        PAIR_ALUR, PAIR_MULDIV, PAIR_LOAD, PAIR_STORE, PAIR_BRANCH, PAIR_JAL,
+        PAIR_JALR, PAIR_FPU, PAIR_AMO, PAIR_OTHER, PAIR_CLASSES
+};
+int riscV_pairClass(u32 instruction);
+const char *riscV_pairClassName(int pairClass);
+u32 riscV_rd(u32 instruction);
+bool riscV_readsReg(u32 instruction, u32 reg);
+
 #endif
 
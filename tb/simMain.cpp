@@ -4,18 +4,69 @@
 #include "testbench.h"
 #include "uartsim.h"
 #include "riscVDis.h"
+#include "dramsim.h"
 
 #define HALT                    SOC__DOT__CPU__DOT__HALT
 #define D_stall                 SOC__DOT__CPU__DOT__D_stall
 #define dataHazard              SOC__DOT__CPU__DOT__dataHazard
+#define longHazard              SOC__DOT__CPU__DOT__decode__DOT__longHazard
+#define loadUseStall            SOC__DOT__CPU__DOT__loadUseStall
+#define LU_fwd                  SOC__DOT__CPU__DOT__decode__DOT__loadUseFwdCount
 #define DE_instr                SOC__DOT__CPU__DOT__DE_instr
 #define E_takeBranch            SOC__DOT__CPU__DOT__E_takeBranch
 #define DE_predictBranch        SOC__DOT__CPU__DOT__DE_predictBranch
 #define DE_predictRA            SOC__DOT__CPU__DOT__DE_predictRA
 #define E_JALRaddr              SOC__DOT__CPU__DOT__execute__DOT__E_JALRaddr
 #define MW_instr                SOC__DOT__CPU__DOT__MW_instr
+#define MW_nop                  SOC__DOT__CPU__DOT__MW_nop
+#define FU_luiAddi              SOC__DOT__CPU__DOT__decode__DOT__fuseLuiAddiCount
+#define FU_auipcAddi            SOC__DOT__CPU__DOT__decode__DOT__fuseAuipcAddiCount
+#define FU_call                 SOC__DOT__CPU__DOT__decode__DOT__fuseCallCount
+#define FU_slliAdd              SOC__DOT__CPU__DOT__decode__DOT__fuseSlliAddCount
+#define FU_luiLoad              SOC__DOT__CPU__DOT__decode__DOT__fuseLuiLoadCount
+#define DUAL_count              SOC__DOT__CPU__DOT__decode__DOT__dualIssueCount
+#define IFQ_fetch               SOC__DOT__CPU__DOT__fetch__DOT__ifqFetchCount
+#define DIV_start               SOC__DOT__CPU__DOT__execute__DOT__idiv__DOT__divStart
+#define DIV_fast                SOC__DOT__CPU__DOT__execute__DOT__idiv__DOT__divFast
+#define DIV_iters               SOC__DOT__CPU__DOT__execute__DOT__idiv__DOT__divIters
+#define DIV_dividendBits        SOC__DOT__CPU__DOT__execute__DOT__idiv__DOT__dividendBits
+#define DIV_divisorBits         SOC__DOT__CPU__DOT__execute__DOT__idiv__DOT__divisorBits
+#define IC_hitCount             SOC__DOT__CPU__DOT__icache__DOT__hitCount
+#define IC_missCount            SOC__DOT__CPU__DOT__icache__DOT__missCount
+#define IC_missCycles           SOC__DOT__CPU__DOT__icache__DOT__missCycles
+#define DC_loadHitCount         SOC__DOT__CPU__DOT__dcache__DOT__loadHitCount
+#define DC_loadMissCount        SOC__DOT__CPU__DOT__dcache__DOT__loadMissCount
+#define DC_storeMissCount       SOC__DOT__CPU__DOT__dcache__DOT__storeMissCount
+#define DC_writebackCount       SOC__DOT__CPU__DOT__dcache__DOT__writebackCount
+#define DC_missCycles           SOC__DOT__CPU__DOT__dcache__DOT__missCycles
+#define DC_sbFullCycles         SOC__DOT__CPU__DOT__dcache__DOT__sbFullCycles
+#define DC_sbForwardCount       SOC__DOT__CPU__DOT__dcache__DOT__sbForwardCount
+#define MMU_itlbHitCount        SOC__DOT__CPU__DOT__mmu__DOT__itlbHitCount
+#define MMU_itlbMissCount       SOC__DOT__CPU__DOT__mmu__DOT__itlbMissCount
+#define MMU_dtlbHitCount        SOC__DOT__CPU__DOT__mmu__DOT__dtlbHitCount
+#define MMU_dtlbMissCount       SOC__DOT__CPU__DOT__mmu__DOT__dtlbMissCount
+#define MMU_walkCycles          SOC__DOT__CPU__DOT__mmu__DOT__walkCycles
+#define MMU_pageFaultCount      SOC__DOT__CPU__DOT__mmu__DOT__pageFaultCount
+#define IRQ_takenCount          SOC__DOT__CPU__DOT__decode__DOT__irqTakenCount
+#define IRQ_waitCycles          SOC__DOT__CPU__DOT__decode__DOT__irqWaitCycles
+#define IRQ_waitMax             SOC__DOT__CPU__DOT__decode__DOT__irqWaitMax
+#define PF_issuedCount          SOC__DOT__CPU__DOT__prefetcher__DOT__issuedCount
+#define PF_usefulCount          SOC__DOT__CPU__DOT__prefetcher__DOT__usefulCount
+#define PF_lateCount            SOC__DOT__CPU__DOT__prefetcher__DOT__lateCount
+#define PF_droppedCount         SOC__DOT__CPU__DOT__prefetcher__DOT__droppedCount
+#define PF_level                SOC__DOT__CPU__DOT__prefetcher__DOT__level
 #define CYCLE                   SOC__DOT__CPU__DOT__csr__DOT__CSR_cycle;
 #define INSTRET                 SOC__DOT__CPU__DOT__csr__DOT__CSR_instret;
+#ifdef DUALCORE
+#define CYCLE1                  SOC__DOT__CPU1__DOT__csr__DOT__CSR_cycle
+#define INSTRET1                SOC__DOT__CPU1__DOT__csr__DOT__CSR_instret
+#define DC_snoopCount           SOC__DOT__CPU__DOT__dcache__DOT__snoopCount
+#define DC_snoopWbCount         SOC__DOT__CPU__DOT__dcache__DOT__snoopWbCount
+#define DC1_snoopCount          SOC__DOT__CPU1__DOT__dcache__DOT__snoopCount
+#define DC1_snoopWbCount        SOC__DOT__CPU1__DOT__dcache__DOT__snoopWbCount
+#define ARB_snoopCount          SOC__DOT__darb__DOT__snoopCount
+#define ARB_snoopWaitCycles     SOC__DOT__darb__DOT__snoopWaitCycles
+#endif
 
 class SOC_TB : public TESTB<VSOC> {
         // Statistics counters
@@ -27,11 +78,51 @@ class SOC_TB : public TESTB<VSOC> {
         IData nbLoad = 0;
         IData nbStore = 0;
         IData nbLoadHazard = 0;
+        IData nbLoadUseStall = 0;
+        IData nbLongHazard = 0;
         IData nbRV32M = 0;
         IData nbMULDIV = 0;
         IData nbFPU = 0;
         IData nbAMO = 0;
 
+        // Divider operand width histograms
+        IData nbDiv = 0;
+        IData nbDivFast = 0;
+        IData nbDivIters = 0;
+        IData divDividendBits[33] = {0};
+        IData divDivisorBits[33] = {0};
+        IData divIters[17] = {0};
+
+        // Dependent instruction pairs in retirement order
+        IData pairCount[PAIR_CLASSES][PAIR_CLASSES] = {{0}};
+        IData prevInstr = 0;
+        bool prevValid = false;
+
+        void updatePairStats(void) {
+                if (m_core->RESET == 1 || rootp->MW_nop == 1)
+                        return;
+                IData instr = rootp->MW_instr;
+                if (prevValid && riscV_readsReg(instr, riscV_rd(prevInstr)))
+                        pairCount[riscV_pairClass(prevInstr)][riscV_pairClass(instr)]++;
+                prevInstr = instr;
+                prevValid = true;
+        }
+
+        void updateDivStats(void) {
+                if (m_core->RESET == 1 || rootp->DIV_start == 0)
+                        return;
+                nbDiv++;
+                divDividendBits[rootp->DIV_dividendBits]++;
+                divDivisorBits[rootp->DIV_divisorBits]++;
+                if (rootp->DIV_fast == 1) {
+                        nbDivFast++;
+                        divIters[0]++;
+                } else {
+                        nbDivIters += rootp->DIV_iters;
+                        divIters[rootp->DIV_iters]++;
+                }
+        }
+
         void updateStats(void) {
                 if (m_core->RESET == 0 && rootp->D_stall == 0) {
                         if (riscV_isBranch(rootp->DE_instr)) {
@@ -61,8 +152,14 @@ class SOC_TB : public TESTB<VSOC> {
                         nbFPU++;
                 if (riscV_isAMO(rootp->MW_instr))
                         nbAMO++;
-                if (rootp->dataHazard == 1)
+                if (rootp->longHazard == 1)
+                        nbLongHazard++;
+                else if (rootp->dataHazard == 1)
                         nbLoadHazard++;
+                if (rootp->loadUseStall == 1)
+                        nbLoadUseStall++;
+                updateDivStats();
+                updatePairStats();
         }
 
 public:
@@ -114,42 +211,37 @@ public:
                 printf("%s: %x (%d)\n", name, reg, reg);
         }
 
+        // Register file banks, the LVT picks the one holding the last write
+        QData fReg(int i) {
+                auto rp = m_core->rootp;
+                if (!((rp->SOC__DOT__CPU__DOT__registers__DOT__fpRegs__DOT__written >> i) & 1))
+                        return 0;
+                return ((rp->SOC__DOT__CPU__DOT__registers__DOT__fpRegs__DOT__lvt >> i) & 1) ?
+                        rp->SOC__DOT__CPU__DOT__registers__DOT__fpRegs__DOT__bankB[i] :
+                        rp->SOC__DOT__CPU__DOT__registers__DOT__fpRegs__DOT__bankA[i];
+        }
+
+        IData xReg(int i) {
+                auto rp = m_core->rootp;
+                if (!((rp->SOC__DOT__CPU__DOT__registers__DOT__intRegs__DOT__written >> i) & 1))
+                        return 0;
+                return ((rp->SOC__DOT__CPU__DOT__registers__DOT__intRegs__DOT__lvt >> i) & 1) ?
+                        rp->SOC__DOT__CPU__DOT__registers__DOT__intRegs__DOT__bankB[i] :
+                        rp->SOC__DOT__CPU__DOT__registers__DOT__intRegs__DOT__bankA[i];
+        }
+
         void printFRegisters(void) {
-                printFReg("ft0",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F0);
-                printFReg("ft1",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F1);
-                printFReg("ft2",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F2);
-                printFReg("ft3",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F3);
-                printFReg("ft4",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F4);
-                printFReg("ft5",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F5);
-                printFReg("ft6",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F6);
-                printFReg("ft7",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F7);
-                // printFReg("fs0",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F8);
-                // printFReg("fs1",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F9);
-                // printFReg("fa0",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F10);
-                // printFReg("fa1",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F11);
-                // printFReg("fa2",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F12);
-                // printFReg("fa3",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F13);
-                // printFReg("fa4",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F14);
-                // printFReg("fa5",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F15);
-                // printFReg("fa6",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F16);
-                // printFReg("fa7",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F17);
-                // printFReg("fs2",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F18);
-                // printFReg("fs3",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F19);
-                // printFReg("fs4",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F20);
-                // printFReg("fs5",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F21);
-                // printFReg("fs6",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F22);
-                // printFReg("fs7",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F23);
-                // printFReg("fs8",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F24);
-                // printFReg("fs9",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F25);
-                // printFReg("fs10", m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F26);
-                // printFReg("fs11", m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F27);
-                // printFReg("ft8",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F28);
-                // printFReg("ft9",  m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F29);
-                // printFReg("ft10", m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F30);
-                // printFReg("ft11", m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_F31);
-
-                printIReg("x6" , m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_6);
-                printIReg("x7" , m_core->rootp->SOC__DOT__CPU__DOT__registers__DOT__reg_7);
+                static const char *names[32] = {
+                        "ft0", "ft1", "ft2",  "ft3",  "ft4", "ft5", "ft6",  "ft7",
+                        "fs0", "fs1", "fa0",  "fa1",  "fa2", "fa3", "fa4",  "fa5",
+                        "fa6", "fa7", "fs2",  "fs3",  "fs4", "fs5", "fs6",  "fs7",
+                        "fs8", "fs9", "fs10", "fs11", "ft8", "ft9", "ft10", "ft11"
+                };
+                for (int i = 0; i < 8; i++)
+                        printFReg(names[i], fReg(i));
+
+                printIReg("x6" , xReg(6));
+                printIReg("x7" , xReg(7));
         }
 
         void printStatusReport(void) {
@@ -161,9 +253,19 @@ public:
                 printf("Branch hit = %3.3f\%%\n", nbBranchHit*100.0/nbBranch);
                 printf("JALR   hit = %3.3f\%%\n", nbJALRhit*100.0/nbJALR);
                 printf("Load hzrds = %3.3f\%%\n", nbLoadHazard*100.0/nbLoad);
+                // Each forwarded load-use used to be a one cycle load hazard
+                printf("Load-use   = %d forwarded, %d stalls, %3.3f\%% forwarded\n",
+                                rootp->LU_fwd, nbLoadUseStall,
+                                rootp->LU_fwd*100.0/(rootp->LU_fwd + nbLoadUseStall));
+                printf("Long hzrds = %d cycles\n", nbLongHazard);
                 printf("Cycles     = %ld\n", cycle);
                 printf("Instret    = %ld\n", instret);
                 printf("CPI        = %3.3f\n",(cycle*1.0)/(instret*1.0));
+                printf("Dual issue = %3.3f\%% of instret\n",
+                                rootp->DUAL_count*100.0/instret);
+                printf("IFQ fetch  = %d while decode stalled\n", rootp->IFQ_fetch);
+
+                // Only the first issue lane is seen here, second lane ALU ops are left out
 
                 printf("Instr. mix = (");
                 printf("Branch:%3.3f\%% | ",            nbBranch*100.0/instret);
@@ -175,9 +277,180 @@ public:
                 printf("FPU:%3.3f\%% | ",               nbFPU*100.0/instret);
                 printf("AMO:%3.3f\%%",                  nbAMO*100.0/instret);
                 printf(")\n");
+                printDivReport();
+                printICacheReport();
+                printDCacheReport();
+                printMMUReport();
+                printIrqReport();
+                printPrefetchReport();
+                printFusionReport(instret);
+#ifdef DUALCORE
+                printCoherenceReport();
+#endif
+                dram_report(cycle);
                 // printFRegisters();
         }
 
+        void printICacheReport(void) {
+                IData hits = rootp->IC_hitCount;
+                IData misses = rootp->IC_missCount;
+                IData fetches = hits + rootp->IC_missCycles;
+
+                printf("\nInstruction cache report\n");
+                printf("----------------------------\n");
+                printf("Fetches    = %d\n", hits);
+                printf("Refills    = %d\n", misses);
+                printf("Refill rate= %3.3f\%%\n", misses*100.0/hits);
+                printf("Miss stall = %d cycles (%3.3f\%%)\n", rootp->IC_missCycles,
+                                rootp->IC_missCycles*100.0/fetches);
+        }
+
+        void printDCacheReport(void) {
+                IData hits = rootp->DC_loadHitCount;
+                IData loads = hits + rootp->DC_loadMissCount;
+
+                printf("\nData cache report\n");
+                printf("----------------------------\n");
+                printf("Load hits  = %d\n", hits);
+                printf("Load misses= %d\n", rootp->DC_loadMissCount);
+                printf("Miss rate  = %3.3f\%%\n", rootp->DC_loadMissCount*100.0/loads);
+                printf("St. misses = %d\n", rootp->DC_storeMissCount);
+                printf("Writebacks = %d\n", rootp->DC_writebackCount);
+                printf("Miss stall = %d cycles\n", rootp->DC_missCycles);
+                printf("SB full    = %d cycles\n", rootp->DC_sbFullCycles);
+                printf("SB forwards= %d\n", rootp->DC_sbForwardCount);
+        }
+
+        // Only translated accesses are counted, so bare mode shows no hits
+        void printMMUReport(void) {
+                IData iMisses = rootp->MMU_itlbMissCount;
+                IData dMisses = rootp->MMU_dtlbMissCount;
+                IData walks = iMisses + dMisses;
+
+                if (walks == 0)
+                        return;
+                printf("\nMMU report\n");
+                printf("----------------------------\n");
+                printf("I-TLB hits = %d\n", rootp->MMU_itlbHitCount);
+                printf("I-TLB walks= %d\n", iMisses);
+                printf("D-TLB hits = %d\n", rootp->MMU_dtlbHitCount);
+                printf("D-TLB walks= %d\n", dMisses);
+                printf("Walk cycles= %3.3f cycles/walk\n", rootp->MMU_walkCycles*1.0/walks);
+                printf("Page faults= %d\n", rootp->MMU_pageFaultCount);
+        }
+
+        // Latency is from an enabled interrupt pending to its trap in decode,
+        // the handler is fetched in the same cycle
+        void printIrqReport(void) {
+                IData taken = rootp->IRQ_takenCount;
+
+                if (taken == 0)
+                        return;
+                printf("\nInterrupt report\n");
+                printf("----------------------------\n");
+                printf("Taken      = %d\n", taken);
+                printf("Entry lat. = %3.3f cycles (max %d)\n",
+                                rootp->IRQ_waitCycles*1.0/taken, rootp->IRQ_waitMax);
+        }
+
+#ifdef DUALCORE
+        void printCoherenceReport(void) {
+                u64 cycle1 = rootp->CYCLE1;
+                u64 instret1 = rootp->INSTRET1;
+                IData snoops = rootp->ARB_snoopCount;
+
+                printf("\nCoherence report\n");
+                printf("----------------------------\n");
+                printf("Hart 1 CPI = %3.3f (%ld instret)\n",
+                                (cycle1*1.0)/(instret1*1.0), instret1);
+                printf("Snoops     = %d\n", snoops);
+                printf("Snoop wait = %3.3f cycles/snoop\n",
+                                rootp->ARB_snoopWaitCycles*1.0/snoops);
+                printf(" Hart | Lines lost | Dirty\n");
+                printf("    0 | %10d | %d\n", rootp->DC_snoopCount, rootp->DC_snoopWbCount);
+                printf("    1 | %10d | %d\n", rootp->DC1_snoopCount, rootp->DC1_snoopWbCount);
+        }
+#endif
+
+        void printPrefetchReport(void) {
+                IData issued = rootp->PF_issuedCount;
+                IData useful = rootp->PF_usefulCount;
+                IData misses = rootp->DC_loadMissCount + rootp->DC_storeMissCount;
+
+                printf("\nPrefetch report\n");
+                printf("----------------------------\n");
+                printf("Issued     = %d\n", issued);
+                printf("Dropped    = %d\n", rootp->PF_droppedCount);
+                printf("Accuracy   = %3.3f\%%\n", useful*100.0/issued);
+                printf("Coverage   = %3.3f\%%\n", useful*100.0/(useful + misses));
+                printf("Late       = %3.3f\%%\n", rootp->PF_lateCount*100.0/useful);
+                printf("Level      = %d\n", rootp->PF_level);
+        }
+
+        // Pairs are counted after fusion and dual issue, build with FUSE=0 and
+        // DUAL=0 to see every pair
+        void printFusionReport(u64 instret) {
+                IData fused = rootp->FU_luiAddi + rootp->FU_auipcAddi +
+                        rootp->FU_call + rootp->FU_slliAdd + rootp->FU_luiLoad;
+
+                printf("\nMacro-op fusion report\n");
+                printf("----------------------------\n");
+                printf("lui+addi   = %d\n", rootp->FU_luiAddi);
+                printf("auipc+addi = %d\n", rootp->FU_auipcAddi);
+                printf("auipc+jalr = %d\n", rootp->FU_call);
+                printf("slli+add   = %d\n", rootp->FU_slliAdd);
+                printf("lui+load   = %d\n", rootp->FU_luiLoad);
+                printf("Fused      = %3.3f\%% of instret\n", fused*200.0/instret);
+
+                printf("Dependent pairs      | Count    | Instret\n");
+                for (int n = 0; n < 12; n++) {
+                        int best1 = 0;
+                        int best2 = 0;
+                        for (int i = 0; i < PAIR_CLASSES; i++) {
+                                for (int j = 0; j < PAIR_CLASSES; j++) {
+                                        if (pairCount[i][j] > pairCount[best1][best2]) {
+                                                best1 = i;
+                                                best2 = j;
+                                        }
+                                }
+                        }
+                        IData count = pairCount[best1][best2];
+                        if (count == 0)
+                                break;
+                        printf("%-8s -> %-8s | %8d | %3.3f\%%\n",
+                                        riscV_pairClassName(best1),
+                                        riscV_pairClassName(best2),
+                                        count, count*100.0/instret);
+                        pairCount[best1][best2] = 0;
+                }
+        }
+
+        void printDivReport(void) {
+                if (nbDiv == 0)
+                        return;
+
+                printf("\nDivider report\n");
+                printf("----------------------------\n");
+                printf("Divides    = %d\n", nbDiv);
+                printf("Fast path  = %3.3f\%%\n", nbDivFast*100.0/nbDiv);
+                printf("Avg iters  = %3.3f\n", nbDivIters*1.0/nbDiv);
+                printf(" Bits | Dividend | Divisor\n");
+                for (int i = 0; i <= 32; i += 4) {
+                        IData nbDividend = 0;
+                        IData nbDivisor = 0;
+                        for (int j = (i == 0 ? 0 : i - 3); j <= i; j++) {
+                                nbDividend += divDividendBits[j];
+                                nbDivisor += divDivisorBits[j];
+                        }
+                        printf("%5d | %8d | %7d\n", i, nbDividend, nbDivisor);
+                }
+                printf("Iters | Count\n");
+                for (int i = 0; i <= 16; i++) {
+                        if (divIters[i] != 0)
+                                printf("%5d | %d\n", i, divIters[i]);
+                }
+        }
+
 };
 
 int main(int argc, char **argv) {